@@ -473,9 +473,14 @@ class Generator(object):
                 len_validation_outputs,
                 NP2STRUCT[validation_type])
             )
+            # sparse attributes, the size depends on the non zero values
+            if self.version == 4:
+                test_size = len(self.dataset.test.resources[0].to_sparse_bin())
+                validation_size = len(
+                    self.dataset.validation.resources[0].to_sparse_bin())
             # size of headers
-            test_header_size = 4 + (4 if self.depth > 1 else 0)
-            validation_header_size = 4 + (4 if self.depth > 1 else 0)
+            test_header_size = 4 + (4 if self.depth > 1 or self.version == 4 else 0)
+            validation_header_size = 4 + (4 if self.depth > 1 or self.version == 4 else 0)
             #train_header_size = 4 + 4 + (4 if self.depth  > 1 else 0)
 
             print('+++')
@@ -540,6 +545,27 @@ class Generator(object):
             # | labels                     |
             # +----------------------------+
 
+            ##
+            # Block ver. 4 (sparse attributes, depth 1)
+            # +----------------------------+
+            # | batch index (unsigned long)|
+            # | (only if is train set)     |
+            # +----------------------------+
+            # | num. elems (unsigned long) |
+            # +----------------------------+
+            # | depth (unsigned long)      |
+            # +----------------------------+
+            # | non zeros (unsigned long)  |
+            # +----------------------------+
+            # | offsets (num. elems + 1)   |
+            # +----------------------------+
+            # | indexes (non zeros)        |
+            # +----------------------------+
+            # | values (non zeros)         |
+            # +----------------------------+
+            # | labels                     |
+            # +----------------------------+
+
             for name, set_ in reversed(self.dataset.data.items()):
                 print("+++ Writing {} set".format(name))
                 for idx, resource in enumerate(tqdm(set_.resources)):
@@ -547,7 +573,13 @@ class Generator(object):
                     if name == "train" and self.version != 2:
                         gz_file.write(struct.pack("<I", idx))
                     # depth
-                    if self.version == 3:
+                    if self.version == 4:
+                        # num. elems
+                        gz_file.write(struct.pack("<I", len(resource)))
+                        gz_file.write(struct.pack("<I", 1))
+                        # non zeros, offsets, indexes, values and labels
+                        gz_file.write(resource.to_sparse_bin())
+                    elif self.version == 3:
                         # num. elems
                         gz_file.write(struct.pack("<I", len(resource.outputs)))
                         gz_file.write(struct.pack("<I", self.depth))
@@ -564,8 +596,10 @@ class Generator(object):
 
 def mnist(out_filename, source_folder, dest_folder=getcwd(), depth=1,
           one_hot=True, normalized=True, out_type="float", balanced_classes=False,
-          n_batch=None, batch_size=None, validation_size=2000, validation_as_copy=False, save_stats=False):
+          n_batch=None, batch_size=None, validation_size=2000, validation_as_copy=False, save_stats=False,
+          sparse=False):
     """Create a mnist dataset for DENN."""
+    assert not sparse or depth == 1, "Sparse attributes have depth 1"
 
     dataset_params = {
         'mnist_source_folder': source_folder,
@@ -595,7 +629,7 @@ def mnist(out_filename, source_folder, dest_folder=getcwd(), depth=1,
     if depth > 1:
         actions.append(('modifier', 'add_depth', (depth,), {}))
 
-    version = 3 if depth > 1 else 1
+    version = 4 if sparse else (3 if depth > 1 else 1)
 
     generator = Generator('MNISTDataset', dataset_params, actions,
                           version=version, out_type=out_type, depth=depth)
@@ -623,9 +657,11 @@ def nbit_parity(out_filename, nbit=None, dest_folder=getcwd(), depth=1,
           test_all_values = False, 
           validation_size=0.1, test_size = 0.1, 
           save_stats=False,
-          binary = False
+          binary = False,
+          sparse=False
           ):
     """Create a mnist dataset for DENN."""
+    assert not sparse or depth == 1, "Sparse attributes have depth 1"
 
     dataset_params = {
         'nbit': nbit or 8,
@@ -662,7 +698,7 @@ def nbit_parity(out_filename, nbit=None, dest_folder=getcwd(), depth=1,
     if depth > 1:
         actions.append(('modifier', 'add_depth', (depth,), {}))
 
-    version = 3 if depth > 1 else 1
+    version = 4 if sparse else (3 if depth > 1 else 1)
 
     generator = Generator('NBitParity', dataset_params, actions, version=version, out_type=out_type, depth=depth)
     generator.execute_actions()
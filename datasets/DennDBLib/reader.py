@@ -150,6 +150,21 @@ class Resource(object):
             NP2STRUCT[self.attributes.dtype]
         ), *data)
 
+    def to_sparse_bin(self):
+        """Convert to binary this resource, attributes in compressed rows."""
+        attributes = self.attributes.reshape(len(self.attributes), -1)
+        samples, features = np.nonzero(attributes)
+        values = attributes[samples, features]
+        offsets = np.concatenate(
+            [[0], np.cumsum(np.count_nonzero(attributes, axis=1))])
+        labels = self.outputs.flatten()
+        type_ = NP2STRUCT[self.attributes.dtype]
+        return struct.pack("<I", values.size) + \
+            struct.pack("<{}i".format(offsets.size), *offsets) + \
+            struct.pack("<{}i".format(features.size), *features) + \
+            struct.pack("{}{}".format(values.size, type_), *values) + \
+            struct.pack("{}{}".format(labels.size, type_), *labels)
+
     def __add__(self, other):
         if len(self.attributes) > 0:
             attributes = np.concatenate(
@@ -48,6 +48,24 @@ public:
 			m_count      = count;
 		}
 	};
+	struct PrescreeningContext
+	{
+		bool				m_enabled{ false }; //prescreening and a network with an int8 pass (see NeuralNetwork::quantizable)
+		std::atomic<size_t> m_screened{ 0 }; //sons evaluated with int8 products
+		std::atomic<size_t> m_rejected{ 0 }; //sons discarded without the exact evaluation
+        //
+		void reset(bool enabled)
+		{
+			m_enabled = enabled;
+			m_screened = 0;
+			m_rejected = 0;
+		}
+		//fraction of the selections decided by the int8 pass
+		Scalar rate() const
+		{
+			return m_screened ? Scalar(m_rejected) / Scalar(m_screened) : Scalar(0);
+		}
+	};
 	struct BestContext
 	{
 		Individual::SPtr m_best;
@@ -119,6 +137,11 @@ public:
 		return m_restart_ctx;
 	}
 
+	const PrescreeningContext& prescreening_context() const
+	{
+		return m_prescreening_ctx;
+	}
+
 	Random& population_random(size_t i) const
 	{
 		return m_population_random[i];
@@ -221,6 +244,9 @@ protected:
 	bool serial_find_best_on_validation(size_t& out_i, Scalar& out_eval);
 	bool parallel_find_best_on_validation(ThreadPool& thpool, size_t& out_i, Scalar& out_eval);
 	/////////////////////////////////////////////////////////////////
+	//eval a network on the test set split in shards (one for each thread)
+	Scalar execute_on_shards(Evaluation& function, const NeuralNetwork& network) const;
+	/////////////////////////////////////////////////////////////////
 	//Intermedie steps
 	void execute_a_pass(size_t pass, size_t n_sub_pass);
 	void execute_a_sub_pass(size_t gen);
@@ -235,11 +261,21 @@ protected:
 	void serial_execute_pass();
 	void parallel_execute_pass(ThreadPool& thpool);
 	void  execute_generation_task(size_t i);
+	//son = the son i, or its float copy if the population is packed
+	void  execute_generation_create_task(size_t i, Individual& son);
+	bool  execute_generation_prescreening(size_t i, const NeuralNetwork& son, NeuralNetwork::Workspace& workspace);
+	void  execute_generation_group_task(size_t start, size_t end);
 	/////////////////////////////////////////////////////////////////
+	//size of the groups evaluated in a single pass (0 = one by one, as the packed populations)
+	size_t population_batch() const;
+	//the network of an individual, a packed genome is decoded into a network of the thread
+	const NeuralNetwork& evaluation_network(const Individual& individual) const;
 	//eval all
 	void execute_loss_function_on_all_population(Population& population) const;
 	void serial_execute_loss_function_on_all_population(Population& population) const;
 	void parallel_execute_loss_function_on_all_population(Population& population,ThreadPool& thpool) const;
+	void execute_loss_function_on_a_group(Population& population, size_t start, size_t end, bool feedforward) const;
+	void execute_loss_function_on_a_group(Population& population, const std::vector<size_t>& group, bool feedforward) const;
 	/////////////////////////////////////////////////////////////////
 	//gen random function
 	RandomFunction       gen_random_func() const;
@@ -254,7 +290,6 @@ protected:
 	mutable RandomList m_population_random;
 	//multi threads
 	ThreadPool*			  m_thpool;
-	mutable PromiseList	  m_promises;
 	//serach space
 	DBPopulation          m_population;
 	Evaluation::SPtr      m_loss_function;
@@ -269,11 +304,13 @@ protected:
 	bool				  m_nnmask_bchanged{false};
 	//dataset
 	Individual::SPtr      m_default;
+	const Instance&		  m_instance;
 	DataSetLoader*		  m_dataset_loader;
 	TestSetStream         m_dataset_batch;
 	//Execution Context
 	BestContext		      m_best_ctx;
 	RestartContext		  m_restart_ctx;
+	PrescreeningContext	  m_prescreening_ctx;
 	//params of DE
 	Parameters 		      m_params;
 	EvolutionMethod::SPtr m_e_method;
@@ -65,6 +65,7 @@
 //core
 #include "Core/Scalar.h"
 #include "Core/EigenAlias.h"
+#include "Core/Half.h"
 #include "Core/Variant.h"
 #include "Core/Random.h"
 #include "Core/TicksTime.h"
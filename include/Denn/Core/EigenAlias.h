@@ -1,5 +1,6 @@
 #pragma once
 #include <Eigen/Eigen>
+#include <Eigen/SparseCore>
 #include "Scalar.h"
 
 namespace Denn 
@@ -40,6 +41,11 @@ namespace Denn
 	using MatrixF	 = typename Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>;
 	using Matrix 	 = typename Eigen::Matrix<Scalar, Eigen::Dynamic, Eigen::Dynamic > ;
 
+	//compressed columns (a column is a sample)
+	template < typename T >
+	using SparseMatrixT = typename Eigen::SparseMatrix<T, Eigen::ColMajor, int>;
+	using SparseMatrix  = typename Eigen::SparseMatrix<Scalar, Eigen::ColMajor, int>;
+
 	template < typename T >
 	using MatrixListT  = std::vector < MatrixT< T > >;
 	using MatrixListF  = std::vector < MatrixF >;
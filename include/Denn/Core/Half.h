@@ -0,0 +1,126 @@
+#pragma once
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+
+namespace Denn
+{
+	//storage format of a genome
+	enum class GenomePrecision
+	{
+		GP_FLOAT,
+		GP_FP16,
+		GP_BF16
+	};
+
+	inline bool genome_precision_from_string(const std::string& name, GenomePrecision& precision)
+	{
+		if (name == "float") { precision = GenomePrecision::GP_FLOAT; return true; }
+		if (name == "fp16")  { precision = GenomePrecision::GP_FP16;  return true; }
+		if (name == "bf16")  { precision = GenomePrecision::GP_BF16;  return true; }
+		return false;
+	}
+
+namespace internal
+{
+	inline uint32_t float_bits(float value)
+	{
+		uint32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	inline float bits_float(uint32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//float -> bfloat16, round to nearest even
+	inline uint16_t float_to_bf16(float value)
+	{
+		uint32_t bits = float_bits(value);
+		//nan stays nan
+		if ((bits & 0x7fffffff) > 0x7f800000) return uint16_t((bits >> 16) | 0x0040);
+		bits += 0x7fff + ((bits >> 16) & 1);
+		return uint16_t(bits >> 16);
+	}
+
+	//bfloat16 -> float, exact
+	inline float bf16_to_float(uint16_t value)
+	{
+		return bits_float(uint32_t(value) << 16);
+	}
+
+	//float -> IEEE half, round to nearest even
+	inline uint16_t float_to_fp16(float value)
+	{
+		uint32_t bits = float_bits(value);
+		uint32_t sign = (bits >> 16) & 0x8000;
+		uint32_t mantissa = bits & 0x007fffff;
+		int exponent = int((bits >> 23) & 0xff);
+		//inf/nan
+		if (exponent == 0xff) return uint16_t(sign | 0x7c00 | (mantissa ? 0x0200 : 0));
+		//rebias
+		exponent = exponent - 127 + 15;
+		//overflow
+		if (exponent >= 0x1f) return uint16_t(sign | 0x7c00);
+		//subnormal or zero
+		if (exponent <= 0)
+		{
+			if (exponent < -10) return uint16_t(sign);
+			mantissa |= 0x00800000;
+			uint32_t shift = uint32_t(14 - exponent);
+			uint32_t half = mantissa >> shift;
+			uint32_t rest = mantissa & ((1u << shift) - 1);
+			uint32_t halfway = 1u << (shift - 1);
+			if (rest > halfway || (rest == halfway && (half & 1))) ++half;
+			return uint16_t(sign | half);
+		}
+		//normal (the carry of the rounding can move to the exponent)
+		uint32_t half = sign | (uint32_t(exponent) << 10) | (mantissa >> 13);
+		uint32_t rest = mantissa & 0x1fff;
+		if (rest > 0x1000 || (rest == 0x1000 && (half & 1))) ++half;
+		return uint16_t(half);
+	}
+
+	//IEEE half -> float, exact
+	inline float fp16_to_float(uint16_t value)
+	{
+		uint32_t sign = uint32_t(value & 0x8000) << 16;
+		uint32_t exponent = (value >> 10) & 0x1f;
+		uint32_t mantissa = value & 0x03ff;
+		//inf/nan
+		if (exponent == 0x1f) return bits_float(sign | 0x7f800000 | (mantissa << 13));
+		//normal
+		if (exponent) return bits_float(sign | ((exponent + 112) << 23) | (mantissa << 13));
+		//zero
+		if (!mantissa) return bits_float(sign);
+		//subnormal, normalize
+		int shift = 0;
+		while (!(mantissa & 0x0400)) { mantissa <<= 1; ++shift; }
+		mantissa &= 0x03ff;
+		return bits_float(sign | (uint32_t(113 - shift) << 23) | (mantissa << 13));
+	}
+
+	//encode a buffer
+	template < typename T >
+	inline void pack_genome(GenomePrecision precision, const T* in, uint16_t* out, size_t size)
+	{
+		if (precision == GenomePrecision::GP_BF16) for (size_t i = 0; i != size; ++i) out[i] = float_to_bf16(float(in[i]));
+		else                                       for (size_t i = 0; i != size; ++i) out[i] = float_to_fp16(float(in[i]));
+	}
+
+	//decode a buffer
+	template < typename T >
+	inline void unpack_genome(GenomePrecision precision, const uint16_t* in, T* out, size_t size)
+	{
+		if (precision == GenomePrecision::GP_BF16) for (size_t i = 0; i != size; ++i) out[i] = T(bf16_to_float(in[i]));
+		else                                       for (size_t i = 0; i != size; ++i) out[i] = T(fp16_to_float(in[i]));
+	}
+
+} // namespace internal
+
+} // namespace Denn
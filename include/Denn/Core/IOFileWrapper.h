@@ -1,6 +1,9 @@
 #pragma once 
 #include <cstdio>
+#include <cstring>
+#include <climits>
 #include <string>
+#include <algorithm>
 #include <zlib.h>
 
 #ifdef _MSC_VER
@@ -19,6 +22,9 @@ class std_file
     FILE* m_file{ nullptr };
     
 public:
+
+    //size() is the size of the file
+    static constexpr bool exact_size{ true };
     
     bool open(const std::string& pathfile,const std::string& mode)
     {
@@ -101,6 +107,10 @@ class zlib_file
 	unsigned int m_file_size{ 0       };
     
 public:
+
+    //size() is the ISIZE of the gzip trailer, the uncompressed size modulo 2^32,
+    //a truncated stream is detected only by a short read
+    static constexpr bool exact_size{ false };
     
     bool open(const std::string& pathfile,const std::string& mode)
     {
@@ -156,9 +166,18 @@ public:
         return gzwrite(m_file, data,(int)(size * count));
     }
     
+    //complete elements read, as fread (a gzread reads at most INT_MAX bytes)
     size_t read(void* data,size_t size,size_t count)
     {
-        return gzread(m_file, data, (int)(size * count));
+        const size_t bytes = size * count;
+        size_t n_read = 0;
+        while (n_read < bytes)
+        {
+            int n = gzread(m_file, (unsigned char*)data + n_read, (unsigned int)std::min<size_t>(bytes - n_read, INT_MAX));
+            if (n <= 0) break;
+            n_read += size_t(n);
+        }
+        return size ? n_read / size : 0;
     }
     
     size_t tell() const
@@ -173,18 +192,18 @@ public:
     
     void seek_set(size_t pos = 0)
     {
-        gzseek(m_file, (int)pos, SEEK_SET);
+        gzseek(m_file, (z_off_t)pos, SEEK_SET);
     }
     
     void seek_end(size_t pos = 0)
     {
         denn_assert(0);
-        gzseek(m_file, (int)pos, SEEK_END);
+        gzseek(m_file, (z_off_t)pos, SEEK_END);
     }
     
     void seek_cur(size_t pos = 0)
     {
-        gzseek(m_file, (int)pos, SEEK_CUR);
+        gzseek(m_file, (z_off_t)pos, SEEK_CUR);
     }
     
     bool eof() const
@@ -221,6 +240,95 @@ protected:
 
 };
 
+//read only file mapped in memory
+class mmap_file
+{
+
+    const unsigned char* m_data{ nullptr };
+    size_t               m_size{ 0 };
+    size_t               m_pos { 0 };
+    void*                m_handle{ nullptr };
+
+public:
+
+    mmap_file() {}
+    mmap_file(const mmap_file&) = delete;
+    mmap_file& operator = (const mmap_file&) = delete;
+
+    //size() is the size of the file
+    static constexpr bool exact_size{ true };
+
+    ~mmap_file()
+    {
+        close();
+    }
+
+    bool open(const std::string& pathfile,const std::string& mode);
+
+    void close();
+
+    bool is_open() const
+    {
+        return m_data != nullptr;
+    }
+
+    size_t write(const void* data,size_t size,size_t count)
+    {
+        return 0;
+    }
+
+    size_t read(void* data,size_t size,size_t count)
+    {
+        //n elements in the file
+        count = std::min(count, size ? (m_size - m_pos) / size : 0);
+        //copy
+        std::memcpy(data, m_data + m_pos, size * count);
+        m_pos += size * count;
+        return count;
+    }
+
+    size_t tell() const
+    {
+        return m_pos;
+    }
+
+    void rewind()
+    {
+        m_pos = 0;
+    }
+
+    void seek_set(size_t pos = 0)
+    {
+        m_pos = std::min(pos, m_size);
+    }
+
+    void seek_end(size_t pos = 0)
+    {
+        m_pos = m_size - std::min(pos, m_size);
+    }
+
+    void seek_cur(size_t pos = 0)
+    {
+        m_pos = std::min(m_pos + pos, m_size);
+    }
+
+    bool eof() const
+    {
+        return m_pos >= m_size;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //memory of the file at the current position
+    const void* data() const
+    {
+        return m_data + m_pos;
+    }
+};
+
 #if 0
 template < size_t block_size = 9, size_t work_factor = 30 >
 class bzip2_file
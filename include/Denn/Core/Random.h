@@ -1,8 +1,48 @@
 #pragma once
 #include <random>
+#include <cstdint>
 
 namespace Denn
 {
+	//counter-based generator (Philox4x32-10), the state is a key (the seed) and a counter
+	//the i-th block of 4 values depends only on (key, i), so a stream is reproducible and cheap to store
+	class Philox4x32
+	{
+	public:
+
+		using result_type = uint32_t;
+
+		static constexpr result_type min() { return 0; }
+		static constexpr result_type max() { return 0xFFFFFFFF; }
+
+		Philox4x32(uint64_t value = 0) { seed(value); }
+
+		//restart the stream
+		void seed(uint64_t value);
+
+		//next value
+		result_type operator()()
+		{
+			if (m_i == 4) next_block();
+			return m_block[m_i++];
+		}
+
+		//next n values, as n calls of operator()
+		void generate(result_type* out, size_t n);
+
+		//philox bijection, out = f_key(counter)
+		static void block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]);
+
+	protected:
+
+		void next_block();
+
+		uint32_t m_key[2];
+		uint32_t m_counter[4];
+		uint32_t m_block[4];
+		uint32_t m_i{ 4 };
+	};
+
 	class Random
 	{
 		//random deck
@@ -54,13 +94,27 @@ namespace Denn
 
 	public:
 
+		//number generators
+		enum Generator
+		{
+			RG_MT19937, //std::mt19937 (default)
+			RG_PHILOX   //Philox4x32-10, counter-based
+		};
+
+		//generator by name ("mt19937", "philox"), false if unknown
+		static bool generator_by_name(const std::string& name, Generator& generator);
+
 		Random() : Random (std::random_device{}()) {}
 
-		Random(unsigned int value);
+		Random(unsigned int value, Generator generator = RG_MT19937);
 
 		Random(const Random& random) ;
-		//reinit
+		//reinit (same generator)
 		void reinit(unsigned int seed = std::random_device{}());
+		//reinit (change generator)
+		void reinit(unsigned int seed, Generator generator);
+		//current generator
+		Generator generator() const { return m_generator_type; }
 
 		//random integer in [0, max)
 		int irand(int max = std::numeric_limits<int>::max());
@@ -86,6 +140,13 @@ namespace Denn
 		//random value generated by cauchy[/Lorentz] distribution given a location and a scale in flooting point
 		Scalar cauchy(Scalar location, Scalar scale);
 
+		//bulk fills, out[0,n) get the same values of n calls of uniform/normal/cauchy
+		void uniform_fill(Scalar* out, size_t n, Scalar min = 0.0, Scalar max = 1.0);
+
+		void normal_fill(Scalar* out, size_t n, Scalar mean = 0.0, Scalar stddev = 1.0);
+
+		void cauchy_fill(Scalar* out, size_t n, Scalar location, Scalar scale);
+
 		//get deck
 		RandomDeck& 		   deck() 			   const { return m_deck; }
 		RandomDeckRingSegment& deck_ring_segment() const { return m_deck_ring_segment; }
@@ -93,7 +154,9 @@ namespace Denn
 	protected:
 
 		//number generator
-		std::mt19937 		           m_generator;
+		Generator                      m_generator_type{ RG_MT19937 };
+		std::unique_ptr<std::mt19937>  m_generator;
+		Philox4x32                     m_philox;
 		mutable RandomDeck   	       m_deck;
 		mutable RandomDeckRingSegment  m_deck_ring_segment;
 
@@ -1,5 +1,7 @@
 #pragma once
 #include <mutex>
+#include <deque>
+#include <atomic>
 #include <thread>
 #include <future>
 #include <condition_variable>
@@ -10,15 +12,60 @@ namespace Denn
 	using Promise     = std::future<void>;
 	using PromiseList = std::vector< Promise >;
 	//
+	class Latch
+	{
+	public:
+
+		Latch(size_t count = 0) : m_count(count) {}
+
+		//set counter
+		void reset(size_t count)
+		{
+			m_count = count;
+		}
+
+		//dec counter, wake up the waiting threads at 0
+		void count_down(size_t n = 1)
+		{
+			if (m_count.fetch_sub(n) == n)
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_condition.notify_all();
+			}
+		}
+
+		//all done?
+		bool ready() const
+		{
+			return m_count == 0;
+		}
+
+		//wait (blocking) until the counter is 0
+		void wait()
+		{
+			if (ready()) return;
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_condition.wait(lock, [this]() { return ready(); });
+		}
+
+	protected:
+
+		std::atomic<size_t>		m_count;
+		std::mutex				m_mutex;
+		std::condition_variable m_condition;
+
+	};
+	using LatchPtr = std::shared_ptr< Latch >;
+	//
 	class ThreadPool
 	{
 	public:
 		//type ok callback
-		using TaskFunction = std::function<void(void)>;
+		using TaskFunction  = std::function<void(void)>;
+		using RangeFunction = std::function<void(size_t start, size_t end)>;
 		//list of task to do
 		using ConditionVariable = std::condition_variable;
 		using Mutex			    = std::mutex;
-		using Tasks				= std::queue < TaskFunction >;
 		using Workers			= std::vector< std::thread >;
 
 		//constructors
@@ -47,16 +94,8 @@ namespace Denn
 			auto task = std::make_shared < std::packaged_task<return_type()> >(fun_task);
 			//return future result
 			std::future<return_type> res = task->get_future();
-			{
-				//lock m_woker_tasks
-				std::unique_lock<std::mutex> lock(this->m_workers_mutex);
-				// don't allow enqueueing after stopping the pool
-				if (this->m_workers_stop) throw std::runtime_error("push a task on stopped thread pool");
-				//push
-				this->m_workers_tasks.emplace([task]() { (*task)(); });
-			}
-			//notify push
-			m_workers_condition.notify_one();
+			//push
+			push_simple_task([task]() { (*task)(); });
 			//return promise
 			return res;
 		}
@@ -74,16 +113,8 @@ namespace Denn
 			);
 			//return future result
 			std::future<return_type> res = task->get_future();
-			{
-				//lock m_woker_tasks
-				std::unique_lock<std::mutex> lock(this->m_workers_mutex);
-				// don't allow enqueueing after stopping the pool
-				if (this->m_workers_stop) throw std::runtime_error("push a task on stopped thread pool");
-				//push
-				this->m_workers_tasks.emplace([task]() { (*task)(); });
-			}
-			//notify push
-			m_workers_condition.notify_one();
+			//push
+			push_simple_task([task]() { (*task)(); });
 			//return promise
 			return res;
 		}
@@ -91,30 +122,70 @@ namespace Denn
 		//add a simple task (no return, no args, no promes)
 		inline void push_simple_task(TaskFunction&& task)
 		{
-			//lock
+			//no workers
+			if (!m_queues.size()) throw std::runtime_error("push a task on stopped thread pool");
+			//from a worker: own deque, else round robin
+			size_t q = worker_pool() == this ? worker_id() : (m_next_queue++ % m_queues.size());
+			//add to pending before the push
+			m_tasks_pending += 1;
+			//push
 			{
-				//lock m_woker_tasks
-				std::unique_lock<std::mutex> lock(this->m_workers_mutex);
-				// don't allow enqueueing after stopping the pool
-				if (this->m_workers_stop) throw std::runtime_error("push a task on stopped thread pool");
+				std::unique_lock<std::mutex> lock(m_queues[q]->m_mutex);
+				m_queues[q]->m_tasks.emplace_back(std::forward<TaskFunction>(task));
+			}
+			//notify push
+			notify_pushed(1);
+		}
+
+		//split [start, end) in chunks of grain size (0 = auto) and spread them over the workers
+		inline LatchPtr parallel_for(size_t start, size_t end, size_t grain, RangeFunction function)
+		{
+			//ranges
+			size_t size = end > start ? end - start : 0;
+			size_t n_queues = m_queues.size();
+			//auto grain, ~4 chunks per worker
+			if (!grain) grain = std::max< size_t >(1, size / (std::max< size_t >(n_queues, 1) * 4));
+			//n chunks
+			size_t n_chunks = (size + grain - 1) / grain;
+			//shared state
+			auto range = std::make_shared< RangeTask >(n_chunks, std::move(function));
+			//no work
+			if (!n_chunks) return range;
+			//no workers
+			if (!n_queues) throw std::runtime_error("push a task on stopped thread pool");
+			//add to pending before the push
+			m_tasks_pending += long(n_chunks);
+			//contiguous blocks of chunks for each worker
+			for (size_t q = 0; q != n_queues; ++q)
+			{
+				size_t c_start = (q * n_chunks) / n_queues;
+				size_t c_end = ((q + 1) * n_chunks) / n_queues;
+				if (c_start == c_end) continue;
 				//push
-				this->m_workers_tasks.emplace(std::forward<TaskFunction>(task));
+				std::unique_lock<std::mutex> lock(m_queues[q]->m_mutex);
+				for (size_t c = c_start; c != c_end; ++c)
+				{
+					size_t t_start = start + c * grain;
+					m_queues[q]->m_tasks.emplace_back(range, t_start, std::min(t_start + grain, end));
+				}
 			}
 			//notify push
-			m_workers_condition.notify_one();
+			notify_pushed(n_chunks);
+			//one latch for all
+			return range;
+		}
+
+		//number of workers
+		size_t size() const
+		{
+			return m_workers.size();
 		}
 
 		//wait complate all tasks
 		void wait_all_tasks()
 		{
-			while (m_workers.size()) 
-			{
-				//lock
-				std::unique_lock<std::mutex> lock(m_workers_mutex);
-				//no more staks
-				if(m_workers_tasks.empty() && !m_tasks_in_execution)
-					return;
-			};
+			std::unique_lock<std::mutex> lock(m_workers_mutex);
+			m_idle_condition.wait(lock, [this]() { return m_tasks_pending == 0; });
 		}
 
 		//init
@@ -122,44 +193,54 @@ namespace Denn
 		{
 			//enable
 			this->m_workers_stop = false;
-			this->m_tasks_in_execution = 0;
+			this->m_tasks_queued = 0;
+			this->m_tasks_pending = 0;
+			this->m_next_queue = 0;
+			//a deque for each worker
+			for (size_t i = 0; i < n_threads; ++i)
+			{
+				m_queues.emplace_back(std::make_unique< WorkerQueue >());
+			}
 			//init
 			for (size_t i = 0; i < n_threads; ++i)
 			{
 				m_workers.emplace_back(
-				[this]()
+				[this, i]()
 				{
+					//worker info
+					worker_pool() = this;
+					worker_id() = i;
+					//loop
 					while (true)
 					{
-						TaskFunction task;
+						Task task;
+						//own tasks, or steal
+						if (pop_task(i, task) || steal_task(i, task))
 						{
-							//lock thread
-							std::unique_lock<std::mutex> lock(this->m_workers_mutex);
-							//wait condition
-							this->m_workers_condition.wait(lock,
-							[this]()
+							--m_tasks_queued;
+							//execute
+							task();
+							//release the task before notify
+							task = Task();
+							//dec counter
+							if (--m_tasks_pending == 0)
 							{
-								return this->m_workers_stop || !this->m_workers_tasks.empty();
-							});
-							//exit case
-							if (this->m_workers_stop && this->m_workers_tasks.empty())
-								return;
-							//get task
-							task = std::move(this->m_workers_tasks.front());
-							//pop
-							this->m_workers_tasks.pop();
-							//inc counter of task in execution
-							++m_tasks_in_execution;
+								std::unique_lock<std::mutex> lock(this->m_workers_mutex);
+								m_idle_condition.notify_all();
+							}
+							continue;
 						}
-						//execute
-						task();
-						//dec counter
+						//lock thread
+						std::unique_lock<std::mutex> lock(this->m_workers_mutex);
+						//wait condition
+						this->m_workers_condition.wait(lock,
+						[this]()
 						{
-							//lock thread
-							std::unique_lock<std::mutex> lock(this->m_workers_mutex);
-							//dec counter of task in execution
-							--m_tasks_in_execution;
-						}
+							return this->m_workers_stop || this->m_tasks_queued > 0;
+						});
+						//exit case
+						if (this->m_workers_stop && this->m_tasks_queued <= 0)
+							return;
 					}
 				}
 				);
@@ -180,16 +261,123 @@ namespace Denn
 			for (std::thread& worker : m_workers) worker.join();
 			//clear workers list
 			m_workers.clear();
+			m_queues.clear();
 		}
 
 	protected:
 
-		Workers			  m_workers;		
-		size_t			  m_tasks_in_execution;
-		bool			  m_workers_stop;
-		Mutex			  m_workers_mutex;
-		Tasks			  m_workers_tasks;
-		ConditionVariable m_workers_condition;
+		//parallel_for shared state
+		struct RangeTask : public Latch
+		{
+			RangeTask(size_t count, RangeFunction&& function)
+			: Latch(count)
+			, m_function(std::move(function))
+			{
+			}
+
+			RangeFunction m_function;
+		};
+
+		//a task, simple or a chunk of a range
+		struct Task
+		{
+			Task() {}
+
+			Task(TaskFunction&& function)
+			: m_function(std::move(function))
+			{
+			}
+
+			Task(const std::shared_ptr< RangeTask >& range, size_t start, size_t end)
+			: m_range(range)
+			, m_start(start)
+			, m_end(end)
+			{
+			}
+
+			void operator()()
+			{
+				if (m_range)
+				{
+					m_range->m_function(m_start, m_end);
+					m_range->count_down();
+				}
+				else
+				{
+					m_function();
+				}
+			}
+
+			TaskFunction				 m_function;
+			std::shared_ptr< RangeTask > m_range;
+			size_t						 m_start{ 0 };
+			size_t						 m_end{ 0 };
+		};
+
+		//deque of a worker, owner works on the back, thieves on the front
+		struct WorkerQueue
+		{
+			Mutex			  m_mutex;
+			std::deque< Task > m_tasks;
+		};
+		using WorkerQueues = std::vector< std::unique_ptr< WorkerQueue > >;
+
+		bool pop_task(size_t id, Task& task)
+		{
+			WorkerQueue& queue = *m_queues[id];
+			std::unique_lock<std::mutex> lock(queue.m_mutex);
+			if (queue.m_tasks.empty()) return false;
+			task = std::move(queue.m_tasks.back());
+			queue.m_tasks.pop_back();
+			return true;
+		}
+
+		bool steal_task(size_t id, Task& task)
+		{
+			for (size_t i = 1; i < m_queues.size(); ++i)
+			{
+				WorkerQueue& queue = *m_queues[(id + i) % m_queues.size()];
+				std::unique_lock<std::mutex> lock(queue.m_mutex);
+				if (queue.m_tasks.empty()) continue;
+				task = std::move(queue.m_tasks.front());
+				queue.m_tasks.pop_front();
+				return true;
+			}
+			return false;
+		}
+
+		void notify_pushed(size_t n)
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_workers_mutex);
+				m_tasks_queued += long(n);
+			}
+			if (n == 1) m_workers_condition.notify_one();
+			else        m_workers_condition.notify_all();
+		}
+
+		Workers			   m_workers;
+		WorkerQueues	   m_queues;
+		std::atomic<long>  m_tasks_queued;
+		std::atomic<long>  m_tasks_pending;
+		std::atomic<size_t> m_next_queue;
+		bool			   m_workers_stop;
+		Mutex			   m_workers_mutex;
+		ConditionVariable  m_workers_condition;
+		ConditionVariable  m_idle_condition;
+
+		//worker of the current thread
+		static ThreadPool*& worker_pool()
+		{
+			static thread_local ThreadPool* pool{ nullptr };
+			return pool;
+		}
+
+		static size_t& worker_id()
+		{
+			static thread_local size_t id{ 0 };
+			return id;
+		}
 
 	};
-}
\ No newline at end of file
+}
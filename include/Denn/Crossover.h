@@ -1,6 +1,7 @@
 #pragma once
 #include "Config.h"
 #include "Denn/Population.h"
+#include "Denn/Mutation.h"
 
 namespace Denn
 {	
@@ -20,6 +21,8 @@ namespace Denn
 		using SPtr = std::shared_ptr<Crossover>;
 		//operator
 		virtual void operator()(const Population& population, size_t id_target, Individual& mutant)= 0;
+		//mutation + crossover in a pass, the mutant is computed only where it is kept (false if not supported)
+		virtual bool fused(const Population& population, size_t id_target, const MutationKernels& kernels, Individual& mutant) { return false; }
 		//return ptr
 		SPtr get_ptr() { return this->shared_from_this(); }
 
@@ -36,6 +39,10 @@ namespace Denn
 
 		Random& population_random(size_t i)  const;
 		Random& random(size_t i)  const;
+		//n uniforms in [0,1) of random(i), drawn in bulk (the buffer is per thread, valid until the next call)
+		const Scalar* draw_uniforms(size_t i, size_t n) const;
+		//a matrix of the target, decoded if packed (the buffer is per thread, valid until the next call)
+		ConstAlignedMapMatrix target_matrix(const Individual& target, size_t i_layer, size_t m) const;
 		//help, how is the best
 		bool loss_function_compare(Scalar left, Scalar right) const;
 		bool validation_function_compare(Scalar left, Scalar right) const;
@@ -1,6 +1,9 @@
 #pragma once
 #include "Config.h"
 #include "Shape.h"
+#include "Utilities/ArgMax.h"
+#include "Utilities/SparseInput.h"
+#include "Utilities/Convolution.h"
 
 
 namespace Denn
@@ -8,6 +11,8 @@ namespace Denn
 	class DataSet
 	{
 	public:
+		virtual ~DataSet() {}
+
 		virtual void* ptr_features() const = 0;
 		virtual void* ptr_labels()   const = 0;
 
@@ -19,6 +24,17 @@ namespace Denn
 		
 		virtual DataType get_data_type() const { return DataType::DT_UNKNOWN; }
 
+		//class of each sample (argmax of the labels), computed once by the loaders
+		virtual const ClassIndices& classes() const = 0;
+		virtual void update_classes() = 0;
+
+		//sparse features read by the input layer of a network, nullptr if the features are dense
+		virtual const SparseMatrix* sparse_input() const { return nullptr; }
+
+		//lowered features shared by the first layer of all the networks, nullptr if the features are sparse
+		//(call update() of the cache after the features are changed in place)
+		virtual internal::Im2ColCache* im2col_cache() const { return nullptr; }
+
 		//auto cast
 		template<class T =  Scalar>
 		const Denn::MatrixT<T>&  features() const
@@ -61,17 +77,30 @@ namespace Denn
 	public:
 		Denn::MatrixT< ScalarType > m_features;
 		Denn::MatrixT< ScalarType > m_labels;
+		ClassIndices m_classes;
 		Shape m_features_shape;
 		Shape m_labels_shape;
+		//sparse features (features x samples), m_features is an empty placeholder (0 x samples)
+		Denn::SparseMatrixT< ScalarType > m_sparse_features;
+		//lowered features (a copy of the dataset has an empty cache)
+		mutable internal::Im2ColCache m_im2col_cache;
 
 		inline DataSetX<ScalarType>() {};
 
+		bool sparse() const { return !m_features.rows() && m_sparse_features.rows(); }
+		Denn::SparseMatrixT< ScalarType >& sparse_features() { return m_sparse_features; }
+		const Denn::SparseMatrixT< ScalarType >& sparse_features() const { return m_sparse_features; }
+
 		Denn::MatrixT< ScalarType >&  features() { return m_features; }
 		Denn::MatrixT< ScalarType >&  labels() { return m_labels; }
 		
 		const Denn::MatrixT< ScalarType >&  features() const { return m_features; }
 		const Denn::MatrixT< ScalarType >&  labels() const { return m_labels; }
 
+		ClassIndices& classes() { return m_classes; }
+		virtual const ClassIndices& classes() const override { return m_classes; }
+		virtual void update_classes() override { internal::class_indices(m_labels, m_classes); }
+
 		virtual void* ptr_features()  const override { return (void*)&m_features; }
 		virtual void* ptr_labels()	  const override { return (void*)&m_labels; }
 
@@ -82,9 +111,49 @@ namespace Denn
 		virtual const Shape& labels_shape() const override { return m_labels_shape; }
 
 		virtual DataType get_data_type() const override { return Denn::get_data_type<ScalarType>(); }
+
+		virtual const SparseMatrix* sparse_input() const override { return internal::sparse_input(m_features, m_sparse_features); }
+
+		virtual internal::Im2ColCache* im2col_cache() const override { return sparse() ? nullptr : &m_im2col_cache; }
+	};
+
+	template < typename ScalarType >
+	class DataSetViewX
+	{
+	public:
+
+		using MapMatrix = Eigen::Map< const Denn::MatrixT< ScalarType > >;
+
+		MapMatrix m_features{ nullptr, 0, 0 };
+		MapMatrix m_labels{ nullptr, 0, 0 };
+		Shape m_features_shape;
+		Shape m_labels_shape;
+
+		inline DataSetViewX<ScalarType>() {};
+
+		//view of a memory buffer (no copy)
+		void map(const ScalarType* features, const ScalarType* labels, size_t n_features, size_t n_classes, size_t samples)
+		{
+			new (&m_features) MapMatrix(features, n_features, samples);
+			new (&m_labels) MapMatrix(labels, n_classes, samples);
+		}
+
+		//view of a dataset
+		void map(const DataSetX< ScalarType >& dataset)
+		{
+			map(dataset.features().data(), dataset.labels().data(), dataset.features().rows(), dataset.labels().rows(), dataset.features().cols());
+			m_features_shape = dataset.m_features_shape;
+			m_labels_shape = dataset.m_labels_shape;
+		}
+
+		const MapMatrix&  features() const { return m_features; }
+		const MapMatrix&  labels() const { return m_labels; }
+		const Shape& features_shape() const { return m_features_shape; }
+		const Shape& labels_shape() const { return m_labels_shape; }
 	};
 
 	using DataSetScalar = DataSetX<Scalar>;
+	using DataSetViewScalar = DataSetViewX<Scalar>;
 	using DataSetF = DataSetX<float>;
 	using DataSetD = DataSetX<double>;
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #pragma once
+#include <mutex>
+#include <cstdint>
 #include "Config.h"
 #include "DataSet.h"
 
@@ -27,6 +29,9 @@ namespace Denn
 			default: return DataType::DT_UNKNOWN;
 			}
 		}
+
+		//version 4, features in compressed columns
+		bool sparse() const { return m_version == 4; }
 	});
 
 	/* Version 1 */
@@ -90,6 +95,9 @@ namespace Denn
 
 		virtual bool read_batch(DataSet& t_out, bool loop = true) = 0;
 
+		//read a batch as a view of the file (no cache copy), false if the loader can't (then use read_batch)
+		virtual bool read_batch_view(DataSetViewScalar& t_out, bool loop = true) { return false; }
+
 		virtual size_t number_of_batch_read() const = 0;
 
 		virtual void clear_batch_counter() = 0;
@@ -146,6 +154,8 @@ namespace Denn
 		{
 			if (is_open())
 			{
+				//lock file
+				std::unique_lock<std::recursive_mutex> lock(m_mutex);
 				//save file pos
 				size_t cur_pos = m_file.tell();
 				//set file to test offset 
@@ -159,7 +169,7 @@ namespace Denn
 					m_file.read(&m_test_header, sizeof(DataSetTestHeader), 1);
 					m_test_header.m_n_depth = 1;
 					break;
-				case 3:
+				case 3: case 4:
 					m_file.read(&m_test_header, sizeof(DataSetTestHeaderV2), 1); break;
 				}
 				status = read(t_out, m_test_header.m_n_row, m_test_header.m_n_depth);
@@ -178,6 +188,8 @@ namespace Denn
 		{
 			if (is_open())
 			{
+				//lock file
+				std::unique_lock<std::recursive_mutex> lock(m_mutex);
 				//save file pos
 				size_t cur_pos = m_file.tell();
 				//set file to validation offset 
@@ -189,7 +201,7 @@ namespace Denn
 					m_file.read(&m_val_header, sizeof(DataSetValidationHeader), 1);
 					m_val_header.m_n_depth = 1;
 					break;
-				case 3:
+				case 3: case 4:
 					m_file.read(&m_val_header, sizeof(DataSetValidationHeaderV2), 1); break;
 				}
 				//read data
@@ -208,6 +220,8 @@ namespace Denn
 		{
 			if (is_open())
 			{
+				//lock file
+				std::unique_lock<std::recursive_mutex> lock(m_mutex);
 				//set file to train offset 
 				m_file.seek_set(m_header.m_train_offset);
 				//ok
@@ -220,27 +234,14 @@ namespace Denn
 		{
 			if (is_open())
 			{
+				//lock file
+				std::unique_lock<std::recursive_mutex> lock(m_mutex);
 				//read header
-				switch (m_header.m_version)
-				{
-				default:
-					m_file.read(&m_train_header, sizeof(DataSetTrainHeader), 1);
-					m_train_header.m_n_depth = 1;
-					break;
-				case 3:
-					m_file.read(&m_train_header, sizeof(DataSetTrainHeaderV2), 1); break;
-				}
+				read_train_header();
 				//read data
 				bool status = read(t_out, m_train_header.m_n_row, m_train_header.m_n_depth);
-				//inc count 
-				++m_n_batch_read;
-				//if loop enable and batch is the last
-				if (loop
-					&& int(m_train_header.m_batch_id + 1) == m_header.m_n_batch)
-				{
-					//restart
-					start_read_batch();
-				}
+				//next
+				end_read_batch(loop);
 				return status;
 			}
 			return false;
@@ -259,6 +260,32 @@ namespace Denn
 
 	protected:
 
+		void read_train_header()
+		{
+			switch (m_header.m_version)
+			{
+			default:
+				m_file.read(&m_train_header, sizeof(DataSetTrainHeader), 1);
+				m_train_header.m_n_depth = 1;
+				break;
+			case 3: case 4:
+				m_file.read(&m_train_header, sizeof(DataSetTrainHeaderV2), 1); break;
+			}
+		}
+
+		void end_read_batch(bool loop)
+		{
+			//inc count 
+			++m_n_batch_read;
+			//if loop enable and batch is the last
+			if (loop
+				&& int(m_train_header.m_batch_id + 1) == m_header.m_n_batch)
+			{
+				//restart
+				start_read_batch();
+			}
+		}
+
 		bool read(DataSet& t_out, const unsigned int samples, const unsigned int depth)
 		{
 			if (t_out.get_data_type() == m_header.get_data_type())
@@ -271,6 +298,11 @@ namespace Denn
 				default: return false;
 				}
 			}
+			//sparse features are read only as they are
+			else if (m_header.sparse())
+			{
+				return false;
+			}
 			else
 			{
 				switch (m_header.get_data_type())
@@ -295,6 +327,7 @@ namespace Denn
 					break;
 					default: return false;
 					}
+					t_out.update_classes();
 					return success;
 				}
 				break;
@@ -318,6 +351,7 @@ namespace Denn
 					break;
 					default: return false;
 					}
+					t_out.update_classes();
 					return success;
 				}
 				break;
@@ -341,6 +375,7 @@ namespace Denn
 					break;
 					default: return false;
 					}
+					t_out.update_classes();
 					return success;
 				}
 				break;
@@ -354,31 +389,104 @@ namespace Denn
 		{
 			//equal type?
 			if (t_out.get_data_type() != m_header.get_data_type()) return false;
-			//depth
-			t_out.features().resize(m_header.m_n_features*depth, samples);
-			//levels
-			MatrixT<ScalarType> alevel(m_header.m_n_features, samples);
-			//for depth
-			for (unsigned int d = 0; d != depth; ++d)
+			//sparse
+			if (m_header.sparse())
 			{
-				//read a level
-				m_file.read((void*)(alevel.data()), m_header.m_n_features * samples * sizeof(ScalarType), 1);
-				//append
-				t_out.features().block(m_header.m_n_features*d, 0, m_header.m_n_features*(d+1), samples) = alevel;
+				if (!template_read_sparse(t_out, samples, depth)) return false;
+			}
+			else
+			{
+				if (!template_read_dense(t_out, samples, depth)) return false;
 			}
 			//alloc output
 			//data are in row-major layout then the shape is traspose
 			t_out.labels().resize(m_header.m_n_classes, samples);
 			//read labels
-			m_file.read((void*)(t_out.data_labels()), m_header.m_n_classes * samples * sizeof(ScalarType), 1);
+			if (!read_bytes((void*)(t_out.data_labels()), size_t(m_header.m_n_classes) * samples * sizeof(ScalarType))) return false;
 			//set shape
 			t_out.m_features_shape = Shape(m_header.m_n_features, 1, depth);
 			t_out.m_labels_shape = Shape(m_header.m_n_classes);
+			//classes
+			t_out.update_classes();
 			//ok
 			return true;
 		}
 
+		template < typename ScalarType >
+		bool template_read_dense(DataSetX< ScalarType >& t_out, const unsigned int samples, const unsigned int depth)
+		{
+			//dense
+			t_out.sparse_features().resize(0, 0);
+			//depth
+			t_out.features().resize(m_header.m_n_features*depth, samples);
+			//a level, read in place
+			if (depth == 1)
+			{
+				if (!read_bytes((void*)(t_out.data_features()), size_t(m_header.m_n_features) * samples * sizeof(ScalarType))) return false;
+			}
+			else
+			{
+				//levels
+				MatrixT<ScalarType> alevel(m_header.m_n_features, samples);
+				//for depth
+				for (unsigned int d = 0; d != depth; ++d)
+				{
+					//read a level
+					if (!read_bytes((void*)(alevel.data()), size_t(m_header.m_n_features) * samples * sizeof(ScalarType))) return false;
+					//append
+					t_out.features().block(m_header.m_n_features*d, 0, m_header.m_n_features, samples) = alevel;
+				}
+			}
+			return true;
+		}
+
+		template < typename ScalarType >
+		bool template_read_sparse(DataSetX< ScalarType >& t_out, const unsigned int samples, const unsigned int depth)
+		{
+			//a level
+			if (depth != 1) return false;
+			//nnz, outer[samples + 1], inner[nnz], values[nnz]
+			unsigned int nnz{ 0 };
+			if (!read_bytes(&nnz, sizeof(unsigned int))) return false;
+			//the file must contain all the arrays (before allocating them)
+			const size_t bytes = (size_t(samples) + 1) * sizeof(int) + size_t(nnz) * (sizeof(int) + sizeof(ScalarType));
+			if (size_t(nnz) > size_t(m_header.m_n_features) * samples || !can_read(bytes)) return false;
+			SparseMatrixT<ScalarType>& features = t_out.sparse_features();
+			features.resize(m_header.m_n_features, samples);
+			features.resizeNonZeros(nnz);
+			if (!read_bytes((void*)(features.outerIndexPtr()), (size_t(samples) + 1) * sizeof(int))
+			||  !read_bytes((void*)(features.innerIndexPtr()), size_t(nnz) * sizeof(int))
+			||  !read_bytes((void*)(features.valuePtr()), size_t(nnz) * sizeof(ScalarType)))
+				return false;
+			//a corrupt file must not give out of bounds indices
+			const int* outer = features.outerIndexPtr();
+			const int* inner = features.innerIndexPtr();
+			if (outer[0] != 0 || size_t(outer[samples]) != size_t(nnz)) return false;
+			for (unsigned int j = 0; j != samples; ++j)
+				if (outer[j] > outer[j + 1]) return false;
+			for (unsigned int k = 0; k != nnz; ++k)
+				if (inner[k] < 0 || inner[k] >= m_header.m_n_features) return false;
+			//placeholder
+			t_out.features().resize(0, samples);
+			//ok
+			return true;
+		}
+
+		//the file can contain size bytes more (unknown for a gz file, see IO::exact_size)
+		bool can_read(size_t size)
+		{
+			return !IO::exact_size || m_file.tell() + size <= m_file.size();
+		}
+
+		//reads size bytes, false if the file ends before (a short read of a gz file)
+		bool read_bytes(void* data, size_t size)
+		{
+			if (!can_read(size)) return false;
+			return !size || m_file.read(data, size, 1) == 1;
+		}
+
 		IO						  m_file;
+		std::recursive_mutex	  m_mutex; //< batches can be read from a prefetch thread
 		size_t 					  m_n_batch_read;
 		DataSetHeader             m_header;
 		DataSetTestHeaderV2       m_test_header;
@@ -386,6 +494,58 @@ namespace Denn
 		DataSetTrainHeaderV2      m_train_header;
 	};
 
+	class DataSetLoaderMMAP : public DataSetLoaderT< IOFileWrapper::mmap_file >
+	{
+	public:
+
+		DataSetLoaderMMAP()
+		{
+		}
+
+		DataSetLoaderMMAP(const std::string& path_file)
+		{
+			open(path_file);
+		}
+
+		///////////////////////////////////////////////////////////////////
+		// READ TRAINING SET (views of the mapped file, only if the data is aligned to Scalar)
+		bool read_batch_view(DataSetViewScalar& t_out, bool loop = true) override
+		{
+			//same type and in bound
+			if (!is_open() || m_header.sparse() || m_header.get_data_type() != get_data_type<Scalar>()) return false;
+			//lock file
+			std::unique_lock<std::recursive_mutex> lock(m_mutex);
+			//save file pos
+			size_t cur_pos = m_file.tell();
+			//read header
+			read_train_header();
+			//size
+			const size_t samples = m_train_header.m_n_row;
+			const size_t features_size = size_t(m_header.m_n_features) * samples;
+			const size_t labels_size = size_t(m_header.m_n_classes) * samples;
+			//the levels are not interleaved in the file, can't be a view
+			//a misaligned Scalar* is undefined behaviour (the 38 bytes of the main header misalign the floats), read_batch copies them
+			if (m_train_header.m_n_depth != 1
+			||  m_file.tell() + (features_size + labels_size) * sizeof(Scalar) > m_file.size()
+			||  reinterpret_cast<std::uintptr_t>(m_file.data()) % alignof(Scalar) != 0)
+			{
+				m_file.seek_set(cur_pos);
+				return false;
+			}
+			//map
+			const Scalar* features = reinterpret_cast<const Scalar*>(m_file.data());
+			const Scalar* labels = features + features_size;
+			t_out.map(features, labels, m_header.m_n_features, m_header.m_n_classes, samples);
+			t_out.m_features_shape = Shape(m_header.m_n_features, 1, 1);
+			t_out.m_labels_shape = Shape(m_header.m_n_classes);
+			//jump data
+			m_file.seek_cur((features_size + labels_size) * sizeof(Scalar));
+			//next
+			end_read_batch(loop);
+			return true;
+		}
+	};
+
 	using DataSetLoaderSTD = DataSetLoaderT< IOFileWrapper::std_file    >;
 	using DataSetLoaderGZ = DataSetLoaderT< IOFileWrapper::zlib_file<> >;
 
@@ -396,7 +556,12 @@ namespace Denn
 		//out put
 		std::string extension = Filesystem::get_extension(path);
 		if (extension == ".gz")    dbloader = std::dynamic_pointer_cast<DataSetLoader>(std::make_shared<DataSetLoaderGZ>(path));
-		else if (extension == ".data")  dbloader = std::dynamic_pointer_cast<DataSetLoader>(std::make_shared<DataSetLoaderSTD>(path));
+		else if (extension == ".data")
+		{
+			//mapped in memory, else read from the stream
+			dbloader = std::dynamic_pointer_cast<DataSetLoader>(std::make_shared<DataSetLoaderMMAP>(path));
+			if (!dbloader->is_open()) dbloader = std::dynamic_pointer_cast<DataSetLoader>(std::make_shared<DataSetLoaderSTD>(path));
+		}
 		//return
 		return dbloader;
 	}
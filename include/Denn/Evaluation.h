@@ -28,6 +28,21 @@ namespace Denn
         virtual bool minimize() const = 0;
         virtual Scalar operator () (const NeuralNetwork&, const DataSet&) = 0;	
         virtual Scalar operator () (const Matrix& predict, const DataSet&) = 0;	
+        //sharded evaluation, the result is reduce(sum of the partials of the shards, samples)
+        virtual bool reducible() const { return false; }
+        virtual Scalar partial(const Matrix& predict, const DataSet&) { return Scalar(0); }
+        virtual Scalar reduce(Scalar partials, size_t samples) const { return partials; }
+        //evaluation on the input of the last softmax (logits), it skips the softmax pass
+        virtual bool from_logits() const { return false; }
+        virtual Scalar logits_partial(const Matrix& logits, const DataSet&) { return Scalar(0); }
+        bool use_logits(const NeuralNetwork& network) const { return from_logits() && network.softmax_output(); }
+        //output = logits ? input of the last softmax : output of the network
+        Scalar evaluate(const Matrix& output, const DataSet& dataset, bool logits)
+        {
+            return logits ? reduce(logits_partial(output, dataset), size_t(dataset.features().cols())) : (*this)(output, dataset);
+        }
+        //classes of the samples of a dataset (computed from the labels if the loader did not)
+        static const ClassIndices& classes(const DataSet& dataset);
     };
 
 	class DefaultEvaluation : public Evaluation
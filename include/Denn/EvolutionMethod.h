@@ -9,7 +9,10 @@ namespace Denn
 	class Parameters;
 	class Random;
 	class DoubleBufferPopulation;
+	class Population;
 	class Individual;
+	class Mutation;
+	class Crossover;
 
 	class EvolutionMethod : public std::enable_shared_from_this< EvolutionMethod >
 	{
@@ -46,6 +49,9 @@ namespace Denn
 		Random& population_random(size_t i)  const;
 		Random& random(size_t i)  const;
 
+		//mutation + crossover, in a pass if the mutation is element-wise and the crossover supports it
+		void mutation_crossover(Mutation& mutation, Crossover& crossover, const Population& population, size_t id_target, Individual& output) const;
+
 		//help, how is the best
 		bool loss_function_compare(Scalar left, Scalar right) const;
 		bool validation_function_compare(Scalar left, Scalar right) const;
@@ -26,6 +26,8 @@ namespace Denn
 		Individual(Scalar f, Scalar cr, Scalar p, const NeuralNetwork& network);
 		//copy attributes from a other individual
 		void copy_from(const Individual& individual);
+		void copy_packed_from(const Individual& individual, GenomePrecision precision);
+		void unpack_from(const Individual& individual);
 		void copy_attributes(const Individual& individual);
 		//cast
 		explicit operator NeuralNetwork&();
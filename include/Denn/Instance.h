@@ -1,4 +1,5 @@
 #pragma once
+#include <mutex>
 #include "Config.h"
 #include "Parameters.h"
 #include "NeuralNetwork.h"
@@ -13,6 +14,7 @@ namespace Denn
 	{
 	public:
 		using SPtr = std::shared_ptr<Instance>;
+		using DataSetShards = std::shared_ptr< const std::vector<DataSetScalar> >;
 
 		Instance();
 		Instance(const Denn::Parameters& parameters);
@@ -30,7 +32,23 @@ namespace Denn
 		virtual SerializeOutput::SPtr serialize_output() const = 0;
 		virtual ThreadPool*			  thread_pool() const = 0;
 
+		//validation and test sets, read once from the dataset loader (std::runtime_error if the set is corrupt)
+		virtual const DataSetScalar&  validation_set() const;
+		virtual const DataSetScalar&  test_set() const;
+		//test set split in shards (one for each thread), kept instead of the whole set:
+		//the cached test set is moved into the shards (test_set() reads it again), 
+		//a call with an other number of shards splits a new list, the old one is alive until its callers release it
+		virtual DataSetShards test_shards(size_t n_shards) const;
+
 		virtual bool execute() = 0;
+
+	protected:
+
+		mutable std::unique_ptr< DataSetScalar > m_validation_set{ nullptr };
+		mutable std::unique_ptr< DataSetScalar > m_test_set{ nullptr };
+		mutable DataSetShards					 m_test_shards{ nullptr };
+		mutable size_t							 m_test_n_shards{ 0 };
+		mutable std::mutex						 m_sets_mutex;
 	};
 
 	//class factory of Instance
@@ -7,6 +7,7 @@ namespace Denn
 {
 	//dec
 	class NeuralNetwork;
+	namespace internal { class Im2ColCache; }
 	//Layer intput type
 	using InputType = float;
 	using Inputs = std::vector< float >;
@@ -58,6 +59,8 @@ namespace Denn
 		using SPtr = std::shared_ptr<Layer>;
 		//Costructor
 		Layer(const std::string& name,Shape in, Shape out): m_name(name), m_in_size(in), m_out_size(out) {}
+		//Copy, the parameters are not copied (see copy())
+		Layer(const Layer& layer): m_name(layer.m_name), m_in_size(layer.m_in_size), m_out_size(layer.m_out_size), m_network(layer.m_network) {}
 		//info layer (serialization)
 		virtual const std::string& name() const { return m_name; }
 		virtual const Inputs inputs() const = 0;
@@ -73,10 +76,38 @@ namespace Denn
 		virtual const Matrix& feedforward(const Matrix& prev_layer_data)		                          = 0;
 		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) = 0;
 		///////////////////////////////////////////////////////////////////////////
+		//stateless pass, the output is written into top (or it is the input itself), the layer is not changed
+		virtual const Matrix& predict(const Matrix& prev_layer_data, Matrix& top) const = 0;
+		virtual const Matrix& feedforward(const Matrix& prev_layer_data, Matrix& top) const { return predict(prev_layer_data, top); }
+		///////////////////////////////////////////////////////////////////////////
+		//feedforward of the same layer of many networks on a shared input (cache = its lowered input, can be null), false if not supported
+		virtual bool population_feedforward(const std::vector<Layer*>& layers, const Matrix& prev_layer_data, internal::Im2ColCache* cache) { return false; }
+		///////////////////////////////////////////////////////////////////////////
+		//fusion, number of the next layers evaluated by the kernel of this layer (e.g. fc+relu), 0 = none
+		virtual size_t fusion(const std::vector<Layer*>& next_layers) const { return 0; }
+		//stateless pass of this layer and of the fused layers
+		virtual const Matrix& fused_predict(const Matrix& prev_layer_data, const std::vector<Layer*>& fused_layers, Matrix& top) const { return predict(prev_layer_data, top); }
+		//int8 approximation of predict (e.g. pre-screening), exact by default
+		virtual const Matrix& quantized_predict(const Matrix& prev_layer_data, Matrix& top) const { return predict(prev_layer_data, top); }
+		//quantized_predict is an int8 pass, cheaper than predict
+		virtual bool quantizable() const { return false; }
+		///////////////////////////////////////////////////////////////////////////
+		//input layer of a sparse dataset (features x samples), only the layers which can read the nonzeros
+		virtual bool sparse_input() const { return false; }
+		virtual const Matrix& sparse_predict(const SparseMatrix& prev_layer_data, Matrix& top) const { denn_assert(0); return top; }
+		virtual const Matrix& sparse_backpropagate(const SparseMatrix& prev_layer_data, const Matrix& next_layer_data) { denn_assert(0); return bp_output(); }
+		///////////////////////////////////////////////////////////////////////////
+		//input layer of a dense dataset, only the layers which read the cache of the dataset (see DataSet::im2col_cache)
+		//stateless pass of this layer and of the fused layers (none if quantized)
+		virtual bool cached_input() const { return false; }
+		virtual const Matrix& cached_predict(const Matrix& prev_layer_data, internal::Im2ColCache& cache, const std::vector<Layer*>& fused_layers, bool quantized, Matrix& top) const { denn_assert(0); return top; }
+		///////////////////////////////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) = 0;
 		///////////////////////////////////////////////////////////////////////////
 		virtual const Matrix& ff_output() = 0;
 		virtual const Matrix& bp_output() = 0;
+		//buffer of ff_output()
+		virtual Matrix& ff_output_buffer() = 0;
 		///////////////////////////////////////////////////////////////////////////
 		virtual size_t				   size()  const              = 0;
 		virtual AlignedMapMatrix       operator[](size_t i)       = 0;
@@ -87,14 +118,32 @@ namespace Denn
 		const Iterator begin() const;
 		const Iterator end()   const;
 		///////////////////////////////////////////////////////////////////////////
+		//parameters, all the matrices of the layer are stored in a single buffer
+		static size_t parameters_align(size_t size);
+		size_t parameters_size() const;
+		//copy the parameters into the buffer and use it as storage (nullptr = self storage)
+		void   parameters_bind(Scalar* buffer = nullptr);
+		//drop the storage of parameters, the shapes are kept (see NeuralNetwork::genome_pack)
+		void   parameters_release();
+		//same kind of layer and same shape of parameters
+		virtual bool same_layout(const Layer& layer) const;
+		//copy the parameters in place, false if the layouts are different
+		bool copy_from(const Layer& layer);
+		///////////////////////////////////////////////////////////////////////////
 		NeuralNetwork*& network()       { return m_network; }
 		NeuralNetwork*  network() const { return m_network; }
 
 	protected:
+		//alloc the self storage of parameters
+		void parameters_alloc();
+		//point the matrices of parameters to the buffer
+		virtual void parameters_map(Scalar* buffer) {}
 
 		const std::string	 m_name; // layer name
 		const Shape			 m_in_size;    // Size of input units
 		const Shape 		 m_out_size;   // Size of output units 
+		//self storage of parameters (empty if it uses an external buffer)
+		ColVector m_parameters;
 		//parent
 		NeuralNetwork* m_network{nullptr};
 
@@ -109,6 +158,7 @@ namespace Denn
 
 		virtual const Matrix& ff_output() override { return m_top; }
 		virtual const Matrix& bp_output() override { RETURN_BACKPROPAGATION(m_grad_bottom); }
+		virtual Matrix& ff_output_buffer() override { return m_top; }
 
 	protected:
 		//ff
@@ -131,6 +181,9 @@ namespace Denn
 		virtual const Inputs inputs() const override { return {}; }
 		///////////////////////////////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& prev_layer_data) override;
+		virtual const Matrix& predict(const Matrix& prev_layer_data, Matrix& top) const override;
+		//apply the activation in place (fusion), each column is a sample
+		virtual void activation_in_place(Matrix& data) const = 0;
 		///////////////////////////////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override { /*none*/ }
 		///////////////////////////////////////////////////////////////////////////
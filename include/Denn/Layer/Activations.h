@@ -10,6 +10,7 @@ namespace Denn
 		Sigmoid(const Shape& shape, const Inputs& inputs);
 		virtual Layer::SPtr copy() const override;
 		virtual const Matrix& feedforward(const Matrix& bottom) override;
+		virtual void activation_in_place(Matrix& data) const override;
 		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
 	};
 	REGISTERED_ACTIVATION_LAYER(Sigmoid, LAYER_NAMES("sigmoid", "sd"))
@@ -20,16 +21,29 @@ namespace Denn
 		ReLU(const Shape& shape, const Inputs& inputs);
 		virtual Layer::SPtr copy() const override;
 		virtual const Matrix& feedforward(const Matrix& bottom) override;
+		virtual void activation_in_place(Matrix& data) const override;
 		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
 	};
 	REGISTERED_ACTIVATION_LAYER(ReLU, LAYER_NAMES("relu"))
 
+	class Tanh : public ActivationLayer
+	{
+	public:
+		Tanh(const Shape& shape, const Inputs& inputs);
+		virtual Layer::SPtr copy() const override;
+		virtual const Matrix& feedforward(const Matrix& bottom) override;
+		virtual void activation_in_place(Matrix& data) const override;
+		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
+	};
+	REGISTERED_ACTIVATION_LAYER(Tanh, LAYER_NAMES("tanh", "th"))
+
 	class LeakyReLU : public ActivationLayer
 	{
 	public:
 		LeakyReLU(const Shape& shape, const Inputs& inputs);
 		virtual Layer::SPtr copy() const override;
 		virtual const Matrix& feedforward(const Matrix& bottom) override;
+		virtual void activation_in_place(Matrix& data) const override;
 		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
 	protected:
 		Scalar m_alpha;
@@ -42,6 +56,7 @@ namespace Denn
 		Softmax(const Shape& shape, const Inputs& inputs);
 		virtual Layer::SPtr copy() const override;
 		virtual const Matrix& feedforward(const Matrix& bottom) override;
+		virtual void activation_in_place(Matrix& data) const override;
 		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
 	};
 	REGISTERED_ACTIVATION_LAYER(Softmax, LAYER_NAMES("softmax", "sm"))
@@ -1,7 +1,7 @@
 #pragma once
 #include "Denn/Config.h"
 #include "Denn/Layer.h"
-#include "Denn/Utilities/Convolution.h"
+#include "Denn/Utilities/Pooling.h"
 
 namespace Denn
 {
@@ -35,6 +35,7 @@ namespace Denn
 		//////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& input) override;
 		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
 		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
 		//////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override;
@@ -42,6 +43,7 @@ namespace Denn
 	protected:    
 		//shape conv
 		internal::ConvDims m_dim;		           // dimensions of convolution
+		internal::PoolingTable m_table;		   // index of the windows
 	};
 
 	REGISTERED_LAYER(
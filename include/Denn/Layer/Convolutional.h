@@ -30,6 +30,8 @@ namespace Denn
 			  const Shape& in
 			, const Inputs& metadata
 		);
+		//the parameters are copied into the own storage of the layer, the maps are not copied
+		Convolutional(const Convolutional& layer);
 		//////////////////////////////////////////////////
 		virtual Layer::SPtr copy() const override;
 		//////////////////////////////////////////////////
@@ -37,23 +39,52 @@ namespace Denn
 		//////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& input) override;
 		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
 		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
 		//////////////////////////////////////////////////
+		virtual bool population_feedforward(const std::vector<Layer*>& layers, const Matrix& input, internal::Im2ColCache* cache) override;
+		//////////////////////////////////////////////////
+		virtual size_t fusion(const std::vector<Layer*>& next_layers) const override;
+		virtual const Matrix& fused_predict(const Matrix& input, const std::vector<Layer*>& fused_layers, Matrix& top) const override;
+		//////////////////////////////////////////////////
+		virtual bool cached_input() const override { return true; }
+		virtual const Matrix& cached_predict(const Matrix& input, internal::Im2ColCache& cache, const std::vector<Layer*>& fused_layers, bool quantized, Matrix& top) const override;
+		//////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override;
 		//////////////////////////////////////////////////
 		virtual size_t size() const operator_override;
 		virtual AlignedMapMatrix      operator[](size_t i) operator_override;
 		virtual ConstAlignedMapMatrix operator[](size_t i) const operator_override;
 		//////////////////////////////////////////////////
+		virtual bool same_layout(const Layer& layer) const override;
+		//////////////////////////////////////////////////
 	protected:    
+		//////////////////////////////////////////////////
+		//a convolution with an other name (e.g. pointwise)
+		Convolutional
+		(
+			  const std::string& name
+			, int in_width, int in_height, int in_channels
+			, int window_width, int window_height, int out_channels
+			, int stride, int pad_w, int pad_h
+		);
+		//////////////////////////////////////////////////
+		virtual void parameters_map(Scalar* buffer) override;
+		//conv of the whole batch, by tiles of samples (cache = lowered input, can be null, save_images = im2col of each sample, for backpropagation)
+		const Matrix& convolution(const Matrix& input, internal::Im2ColCache* cache, Matrix& top, std::vector<Matrix>* save_images) const;
+		//conv + fused layers (activation, activation + max pooling)
+		const Matrix& fused_convolution(const Matrix& input, internal::Im2ColCache* cache, const std::vector<Layer*>& fused_layers, Matrix& top) const;
+		template < typename Output >
+		void convolution_tiles(const Matrix& input, internal::Im2ColCache* cache, std::vector<Matrix>* save_images, Output&& output) const;
+		int samples_per_tile() const;
 		//shape conv
 		internal::ConvDims m_dim;		// dimensions of convolution
 
 		//weight
-		Matrix  m_kernels;		// Kernels parameters. Total length is
-								// (in_channels x out_channels x filter_rows x filter_cols)
-								// See Utils/Convolution.h for its layout
-		ColVector m_bias;	    // Bias term for the output channels, out_channels x 1. (One bias term per channel)
+		AlignedMapMatrix  m_kernels{ nullptr, 0, 0 };	// Kernels parameters. Total length is
+														// (in_channels x out_channels x filter_rows x filter_cols)
+														// See Utils/Convolution.h for its layout
+		AlignedMapColVector m_bias{ nullptr, 0 };	    // Bias term for the output channels, out_channels x 1. (One bias term per channel)
 		
 		//backpropagation
 		CODE_BACKPROPAGATION(
@@ -0,0 +1,80 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Layer.h"
+#include "Denn/Utilities/Depthwise.h"
+
+namespace Denn
+{
+
+	class DepthwiseConvolutional : public DerivableLayer
+	{
+	public:
+		///////////////////////////////////////
+		/// Constructor
+		///
+		/// \param in_width      Width of the input image in each channel.
+		/// \param in_height     Height of the input image in each channel.
+		/// \param in_channels   Number of input channels (and of output channels).
+		/// \param window_width  Width of the filter.
+		/// \param window_height Height of the filter.
+		///
+		DepthwiseConvolutional
+		(
+			  int in_width, int in_height, int in_channels
+			, int window_width, int window_height
+			, int stride = 1, int pad_w = 0, int pad_h = 0
+		);
+		DepthwiseConvolutional
+		(
+			  const Shape& in
+			, const Inputs& metadata
+		);
+		//the maps are bound to the parameters of the layer, not copied
+		DepthwiseConvolutional(const DepthwiseConvolutional& layer);
+		//////////////////////////////////////////////////
+		virtual Layer::SPtr copy() const override;
+		//////////////////////////////////////////////////
+		virtual const Inputs inputs() const override;
+		//////////////////////////////////////////////////
+		virtual const Matrix& predict(const Matrix& input) override;
+		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
+		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
+		//////////////////////////////////////////////////
+		virtual size_t fusion(const std::vector<Layer*>& next_layers) const override;
+		virtual const Matrix& fused_predict(const Matrix& input, const std::vector<Layer*>& fused_layers, Matrix& top) const override;
+		//////////////////////////////////////////////////
+		virtual void update(const Optimizer& optimize) override;
+		//////////////////////////////////////////////////
+		virtual size_t size() const operator_override;
+		virtual AlignedMapMatrix      operator[](size_t i) operator_override;
+		virtual ConstAlignedMapMatrix operator[](size_t i) const operator_override;
+		//////////////////////////////////////////////////
+		virtual bool same_layout(const Layer& layer) const override;
+		//////////////////////////////////////////////////
+	protected:
+		//////////////////////////////////////////////////
+		virtual void parameters_map(Scalar* buffer) override;
+		//shape conv (channel_out = channel_in)
+		internal::ConvDims m_dim;		// dimensions of convolution
+		internal::PoolingTable m_table;	// index of the windows (-1 = padding)
+
+		//weight
+		AlignedMapMatrix  m_kernels{ nullptr, 0, 0 };	// Kernels parameters, a filter for each channel
+														// (filter_rows x filter_cols) x channels
+		AlignedMapColVector m_bias{ nullptr, 0 };	    // Bias term for each channel, channels x 1
+
+		//backpropagation
+		CODE_BACKPROPAGATION(
+			Matrix 	m_grad_kernels; 	 // Derivative of filters, same dimension as m_kernels
+			ColVector m_grad_bias;		 // Derivative of bias, same dimension as m_bias
+		)
+	};
+
+	REGISTERED_LAYER(
+		DepthwiseConvolutional,
+		LAYER_NAMES("depthwise_convolutional", "dwconv"),
+		LayerShapeType(SHAPE_2D_3D),    //shape 2D/3D
+		LayerDescription::MinMax{ 2,5 } //min args filter size, max args filter size + stride + padding
+	)
+}
@@ -35,6 +35,8 @@ namespace Denn
 		//////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& input) override;
 		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
+		virtual const Matrix& feedforward(const Matrix& input, Matrix& top) const override;
 		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
 		//////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override;
@@ -2,6 +2,8 @@
 #include "Denn/Config.h"
 #include "Denn/Layer.h"
 #include "Denn/Utilities/Convolution.h"
+#include "Denn/Utilities/Quantization.h"
+#include "Denn/Utilities/SparseInput.h"
 
 namespace Denn
 {
@@ -25,6 +27,8 @@ namespace Denn
 			  const Shape& in
 			, const Inputs& metadata
 		);
+		//the parameters are copied into the own storage of the layer, the maps are not copied
+		FullyConnected(const FullyConnected& layer);
 		//////////////////////////////////////////////////
 		virtual Layer::SPtr copy() const override;
 		//////////////////////////////////////////////////
@@ -32,8 +36,24 @@ namespace Denn
 		//////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& input) override;
 		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
 		virtual const Matrix& backpropagate(const Matrix& bottom, const Matrix& grad) override;
 		//////////////////////////////////////////////////
+		virtual bool population_feedforward(const std::vector<Layer*>& layers, const Matrix& input, internal::Im2ColCache* cache) override;
+		//////////////////////////////////////////////////
+		virtual size_t fusion(const std::vector<Layer*>& next_layers) const override;
+		virtual const Matrix& fused_predict(const Matrix& input, const std::vector<Layer*>& fused_layers, Matrix& top) const override;
+		//////////////////////////////////////////////////
+		virtual const Matrix& quantized_predict(const Matrix& input, Matrix& top) const override;
+		virtual bool quantizable() const override { return true; }
+		//////////////////////////////////////////////////
+		virtual bool cached_input() const override { return true; }
+		virtual const Matrix& cached_predict(const Matrix& input, internal::Im2ColCache& cache, const std::vector<Layer*>& fused_layers, bool quantized, Matrix& top) const override;
+		//////////////////////////////////////////////////
+		virtual bool sparse_input() const override { return true; }
+		virtual const Matrix& sparse_predict(const SparseMatrix& input, Matrix& top) const override;
+		virtual const Matrix& sparse_backpropagate(const SparseMatrix& bottom, const Matrix& grad) override;
+		//////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override;
 		//////////////////////////////////////////////////
 		virtual size_t size() const operator_override;
@@ -41,9 +61,13 @@ namespace Denn
 		virtual ConstAlignedMapMatrix operator[](size_t i) const operator_override;
 		//////////////////////////////////////////////////
 	protected:    
+		//////////////////////////////////////////////////
+		virtual void parameters_map(Scalar* buffer) override;
+		//int8 product (cache = the input is shared, it is quantized once by each thread, can be null)
+		const Matrix& quantized_fully_connected(const Matrix& input, const internal::Im2ColCache* cache, Matrix& top) const;
 		//weight
-		Matrix m_weight;  // Weight parameters, W(in_size x out_size)
-		ColVector m_bias; // Bias parameters, b(out_size x 1)
+		AlignedMapMatrix    m_weight{ nullptr, 0, 0 }; // Weight parameters, W(in_size x out_size)
+		AlignedMapColVector m_bias{ nullptr, 0 };      // Bias parameters, b(out_size x 1)
 		//backpropagation
 		CODE_BACKPROPAGATION(
 			Matrix m_grad_w;    // Derivative of weights
@@ -0,0 +1,48 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Layer.h"
+
+namespace Denn
+{
+	//mean of each channel (width x height x channels -> channels), it replaces the flatten + fully connected of a CNN
+	class GlobalAvgPooling : public PoolingLayer
+	{
+	public:
+		///////////////////////////////////////
+		/// Constructor
+		///
+		/// \param in_width      Width of the input image in each channel.
+		/// \param in_height     Height of the input image in each channel.
+		/// \param in_channels   Number of input channels.
+		///
+		GlobalAvgPooling
+		(
+			  int in_width, int in_height, int in_channels
+		);
+		GlobalAvgPooling
+		(
+			  const Shape& in
+			, const Inputs& metadata
+		);
+		//////////////////////////////////////////////////
+		virtual Layer::SPtr copy() const override;
+		//////////////////////////////////////////////////
+		virtual const Inputs inputs() const override;
+		//////////////////////////////////////////////////
+		virtual const Matrix& predict(const Matrix& input) override;
+		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
+		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
+		//////////////////////////////////////////////////
+		virtual void update(const Optimizer& optimize) override;
+		//////////////////////////////////////////////////
+	};
+
+	//no inputs, the shape is the output of the previous layer (as an activation)
+	REGISTERED_LAYER(
+		GlobalAvgPooling,
+		LAYER_NAMES("global_avg_pooling", "gap"),
+		LayerShapeType(SHAPE_ACTIVATION),
+		LayerDescription::MinMax{ 0 }
+	)
+}
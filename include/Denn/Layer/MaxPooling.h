@@ -1,7 +1,7 @@
 #pragma once
 #include "Denn/Config.h"
 #include "Denn/Layer.h"
-#include "Denn/Utilities/Convolution.h"
+#include "Denn/Utilities/Pooling.h"
 
 namespace Denn
 {
@@ -35,13 +35,19 @@ namespace Denn
 		//////////////////////////////////////////////////
 		virtual const Matrix& predict(const Matrix& input) override;
 		virtual const Matrix& feedforward(const Matrix& input) override;
+		virtual const Matrix& predict(const Matrix& input, Matrix& top) const override;
 		virtual const Matrix& backpropagate(const Matrix& prev_layer_data, const Matrix& next_layer_data) override;
 		//////////////////////////////////////////////////
 		virtual void update(const Optimizer& optimize) override;
 		//////////////////////////////////////////////////
+		//max pooling of a sample, from an image to a column of output (layer fusion)
+		void pooling(const Scalar* image, Scalar* top) const;
+		//////////////////////////////////////////////////
 	protected:    
 		// dimensions of convolution
 		internal::ConvDims m_dim;		         
+		// index of the windows
+		internal::PoolingTable m_table;
  		// index of max values
 		CODE_BACKPROPAGATION(
 			std::vector<std::vector<int> > m_max_idxs;
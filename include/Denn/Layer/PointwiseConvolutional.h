@@ -0,0 +1,43 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Layer/Convolutional.h"
+
+namespace Denn
+{
+
+	//1x1 convolution, it mixes the channels of each pixel (after a depthwise convolution)
+	class PointwiseConvolutional : public Convolutional
+	{
+	public:
+		///////////////////////////////////////
+		/// Constructor
+		///
+		/// \param in_width      Width of the input image in each channel.
+		/// \param in_height     Height of the input image in each channel.
+		/// \param in_channels   Number of input channels.
+		/// \param out_channels  Number of output channels.
+		///
+		PointwiseConvolutional
+		(
+			  int in_width, int in_height, int in_channels
+			, int out_channels
+		);
+		PointwiseConvolutional
+		(
+			  const Shape& in
+			, const Inputs& metadata
+		);
+		//////////////////////////////////////////////////
+		virtual Layer::SPtr copy() const override;
+		//////////////////////////////////////////////////
+		virtual const Inputs inputs() const override;
+		//////////////////////////////////////////////////
+	};
+
+	REGISTERED_LAYER(
+		PointwiseConvolutional,
+		LAYER_NAMES("pointwise_convolutional", "pwconv"),
+		LayerShapeType(SHAPE_2D_3D),    //shape 2D/3D
+		LayerDescription::MinMax{ 1 }   //channels
+	)
+}
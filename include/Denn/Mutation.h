@@ -50,6 +50,65 @@ namespace Denn
 		#endif
 	};
 
+	//element-wise mutation of a matrix, mutant(e) = clamp(kernel(x_0(e), ..., x_n(e)))
+	struct MutationKernel
+	{
+		enum Type
+		{
+			  MK_DIFF_1  // x_0 + (x_1 - x_2) * f
+			, MK_DIFF_2  // x_0 + ((x_1 - x_2) + (x_3 - x_4)) * f
+			, MK_CURR_TO // x_0 + ((x_1 - x_0) + (x_2 - x_3)) * f
+			, MK_DEGL    // lerp(x_0 + ((x_4 - x_0) + (x_5 - x_6)) * f, x_0 + ((x_1 - x_0) + (x_2 - x_3)) * f, w)
+		};
+		Type          m_type{ MK_DIFF_1 };
+		const Scalar* m_x[7]{ nullptr };
+		Scalar        m_f{ 0 };
+		Scalar        m_w{ 0 };
+		Matrix        m_unpacked[7]; //packed donors (fp16/bf16), decoded
+
+		//mutant of an element, without clamp
+		inline Scalar operator()(size_t e) const
+		{
+			const Scalar* const* x = m_x;
+			switch (m_type)
+			{
+			default:
+			case MK_DIFF_1:  return x[0][e] + (x[1][e] - x[2][e]) * m_f;
+			case MK_DIFF_2:  return x[0][e] + ((x[1][e] - x[2][e]) + (x[3][e] - x[4][e])) * m_f;
+			case MK_CURR_TO: return x[0][e] + ((x[1][e] - x[0][e]) + (x[2][e] - x[3][e])) * m_f;
+			case MK_DEGL:    return Denn::lerp
+				(
+				  x[0][e] + ((x[4][e] - x[0][e]) + (x[5][e] - x[6][e])) * m_f
+				, x[0][e] + ((x[1][e] - x[0][e]) + (x[2][e] - x[3][e])) * m_f
+				, m_w
+				);
+			}
+		}
+	};
+	//a kernel for each matrix of the network (weights and bias of each layer, in order)
+	using MutationKernels = std::vector< MutationKernel >;
+
+	//mutation computed element by element, the crossover can compute the mutant only where it is kept
+	class ElementWiseMutation : public Mutation
+	{
+		public:
+		//ElementWiseMutation
+		ElementWiseMutation(const DennAlgorithm& algorithm);
+		//operation, kernels + mutate
+		virtual void operator()(const Population& population, size_t id_target, Individual& output) override;
+		//the kernels of the output (same random draws of the mutation)
+		virtual void kernels(const Population& population, size_t id_target, Individual& output, MutationKernels& kernels) = 0;
+		//mutant of all the matrices
+		void mutate(const MutationKernels& kernels, Individual& output) const;
+
+		protected:
+
+		//alloc a kernel for each matrix
+		static void kernels_alloc(const Individual& target, MutationKernels& kernels);
+		//the donor x of a kernel, decoded if packed
+		static const Scalar* donor(MutationKernel& kernel, size_t x, const Individual& individual, size_t i_layer, size_t m);
+	};
+
 	//class factory of Mutation methods
 	class MutationFactory
 	{
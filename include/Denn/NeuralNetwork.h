@@ -4,6 +4,9 @@
 
 namespace Denn
 {
+//dec
+class DataSet;
+
 class NeuralNetwork
 {
 public:
@@ -17,7 +20,22 @@ public:
 	{
 		MSE,
 		MULTICLASS_CROSS_ENTROPY,
-		BINARY_CROSS_ENTROPY
+		BINARY_CROSS_ENTROPY,
+		SOFTMAX_CROSS_ENTROPY //gradient on the input of the last softmax (as multiclass if the last layer is not a softmax)
+	};
+	////////////////////////////////////////////////////////////////
+	//kernel of a topology with static shapes (see StaticNetwork.h), logits = without the last softmax
+	using StaticPredict = void(*)(const NeuralNetwork& network, const Matrix& input, Matrix& output, bool logits);
+	////////////////////////////////////////////////////////////////
+	//activations of a stateless pass (e.g. one for each thread)
+	class Workspace
+	{
+	public:
+		//a buffer that is not the input
+		Matrix& output_for(const Matrix& input) { return &input == &m_buffers[0] ? m_buffers[1] : m_buffers[0]; }
+		Matrix& output_for(const SparseMatrix& input) { return m_buffers[0]; }
+	protected:
+		Matrix m_buffers[2];
 	};
 	////////////////////////////////////////////////////////////////
 	//  default constructor 
@@ -25,6 +43,13 @@ public:
 	//  default copy constructor  and assignment operator
 	NeuralNetwork(const NeuralNetwork& nn);
 	NeuralNetwork& operator= (const NeuralNetwork & nn);
+	//copy in place if the layouts are the same, else rebuild the layers
+	void copy_from(const NeuralNetwork& nn);
+	//packed copy (e.g. archives), the genome of nn is encoded into the packed buffer, without a full precision storage
+	void copy_packed_from(const NeuralNetwork& nn, GenomePrecision precision);
+	//float copy, a packed genome of nn is decoded (e.g. to evaluate it)
+	void unpack_from(const NeuralNetwork& nn);
+	bool same_layout(const NeuralNetwork& nn) const;
 	////////////////////////////////////////////////////////////////
 	// add layers
 	template < class ...Layers >
@@ -49,8 +74,34 @@ public:
 		add_layer(layers...);
 	}
 	/////////////////////////////////////////////////////////////////////////
+	//fusion of the layers (e.g. fc+relu, conv+relu+maxp), used by predict and feedforward (not by fit)
+	//if the topology is registered into StaticNetworkFactory, the whole pass is a static kernel
+	void fuse();
+	bool fused() const { return m_fusion; }
+	/////////////////////////////////////////////////////////////////////////
 	const Matrix& predict(const Matrix& input) const;
 	const Matrix& feedforward(const Matrix&, Random* random = nullptr) const;
+	//stateless pass, the activations are stored into the workspace and the layers are not changed
+	//logits = stop before the last softmax (see softmax_output)
+	const Matrix& predict(const Matrix& input, Workspace& workspace, bool logits = false) const;
+	const Matrix& feedforward(const Matrix& input, Workspace& workspace, Random* random = nullptr, bool logits = false) const;
+	//stateless pass with int8 products (fc), an approximation of predict
+	const Matrix& quantized_predict(const Matrix& input, Workspace& workspace, bool logits = false) const;
+	//the features of a dataset, the sparse ones are read by the input layer, the dense ones can be lowered once (see DataSet::im2col_cache)
+	const Matrix& predict(const DataSet& input, Workspace& workspace, bool logits = false) const;
+	const Matrix& feedforward(const DataSet& input, Workspace& workspace, Random* random = nullptr, bool logits = false) const;
+	const Matrix& quantized_predict(const DataSet& input, Workspace& workspace, bool logits = false) const;
+	//output of the last pass (logits = the input of the last softmax)
+	const Matrix& output(bool logits = false) const;
+	//the last layer is a softmax (after at least a layer)
+	bool softmax_output() const;
+	//all the layers with parameters have an int8 pass (see Layer::quantizable), quantized_predict is cheaper than predict
+	bool quantizable() const;
+	//evaluate a group of networks (same topology) on a shared input
+	static void predict(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, bool logits = false);
+	static void feedforward(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, const std::vector<Random*>& randoms, bool logits = false);
+	static void predict(const std::vector<const NeuralNetwork*>& networks, const DataSet& input, bool logits = false);
+	static void feedforward(const std::vector<const NeuralNetwork*>& networks, const DataSet& input, const std::vector<Random*>& randoms, bool logits = false);
 	void backpropagate
 	(
 		const Matrix& input, 
@@ -64,6 +115,30 @@ public:
 		const Optimizer& opt = SGD(),
 		OutputLoss type = MULTICLASS_CROSS_ENTROPY
 	);
+	//fit on the features and the labels of a dataset
+	void fit
+	(
+		const DataSet& dataset,
+		const Optimizer& opt = SGD(),
+		OutputLoss type = MULTICLASS_CROSS_ENTROPY
+	);
+	/////////////////////////////////////////////////////////////////////////
+	//genome, all the parameters of the network in a single buffer (layer by layer)
+	size_t genome_size() const;
+	//copy the parameters into the buffer and use it as storage (nullptr = self storage)
+	void genome_bind(Scalar* buffer = nullptr);
+	//flat view of the genome (padding between the matrices included)
+	AlignedMapColVector      genome();
+	ConstAlignedMapColVector genome() const;
+	//16 bits storage (e.g. archives, population), the layers have no parameters until genome_unpack
+	void genome_pack(GenomePrecision precision);
+	void genome_unpack();
+	bool genome_packed() const { return m_genome_precision != GenomePrecision::GP_FLOAT; }
+	GenomePrecision genome_precision() const { return m_genome_precision; }
+	//the genome as floats (genome_size values), decoded if packed
+	void genome_unpack(Scalar* out) const;
+	//a matrix of the genome, decoded into buffer if packed
+	ConstAlignedMapMatrix genome_matrix(size_t layer, size_t matrix, Matrix& buffer) const;
 	/////////////////////////////////////////////////////////////////////////
 	//no 0 values
 	void no_0_weights();
@@ -111,8 +186,30 @@ public:
 	NeuralNetwork&  operator /= (const NeuralNetwork& right);
 	
 protected:
+	//execute a pass of a group of networks
+	static void population_pass(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, internal::Im2ColCache* cache, const std::vector<Random*>* randoms, bool logits);
+	//execute the layers [from, to), with the fused kernels if fusion is true
+	const Matrix& layers_pass(const Matrix& input, size_t from, size_t to, bool train, bool fusion) const;
+	//execute all layers on the workspace (quantized = int8 approximation, without fusion; logits = without the last softmax; cache = shared input of the first layer)
+	const Matrix& workspace_pass(const Matrix& input, Workspace& workspace, bool train, bool quantized = false, bool logits = false, size_t from = 0, internal::Im2ColCache* cache = nullptr) const;
+	//the same passes with sparse features, the input layer reads the nonzeros, the next layers its output
+	const Matrix& layers_pass(const SparseMatrix& input, size_t to, bool train, bool fusion) const;
+	const Matrix& workspace_pass(const SparseMatrix& input, Workspace& workspace, bool train, bool quantized = false, bool logits = false) const;
+	//gradients of all layers, input (or sparse, if not null) is the input of the first one
+	void backpropagate(const Matrix& input, const SparseMatrix* sparse, const Matrix& output, OutputLoss type);
 	//layer list
 	LayerList m_layers;
+	//fusion, the layers fused with each layer (empty = none)
+	bool m_fusion{false};
+	std::vector< std::vector<Layer*> > m_fused_layers;
+	StaticPredict m_static{nullptr};
+	//genome
+	ColVector m_genome;
+	Scalar*   m_genome_ptr{nullptr};
+	size_t    m_genome_size{0};
+	//packed genome
+	GenomePrecision       m_genome_precision{ GenomePrecision::GP_FLOAT };
+	std::vector<uint16_t> m_genome_packed;
 	//ref to random engine
 	mutable Random* m_random{nullptr};
 };
@@ -122,6 +219,25 @@ inline NeuralNetwork::Scalar distance_pow2<const NeuralNetwork, const NeuralNetw
 {
 	//bad case
 	if(a.size()!=b.size()) return std::numeric_limits<Scalar>::infinity();
+	//packed genomes, decoded (the layers have no parameters)
+	if(a.genome_packed() || b.genome_packed())
+	{
+		if(a.genome_size() != b.genome_size()) return std::numeric_limits<Scalar>::infinity();
+		thread_local ColVector a_genome;
+		thread_local ColVector b_genome;
+		a_genome.resize(a.genome_size());
+		b_genome.resize(b.genome_size());
+		a.genome_unpack(a_genome.data());
+		b.genome_unpack(b_genome.data());
+		return distance_pow2(a_genome, b_genome);
+	}
+	//same layout, flat genome (the padding is always 0)
+	if(a.genome_size() == b.genome_size())
+	{
+		auto a_genome = a.genome();
+		auto b_genome = b.genome();
+		return distance_pow2(a_genome, b_genome);
+	}
 	//value
 	Scalar dpow2 = 0.0;
 	//sum
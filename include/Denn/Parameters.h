@@ -24,6 +24,7 @@ namespace Denn
 		ReadOnly<std::string>			m_dataset_filename           { "dataset" };
 		ReadOnly<size_t>			    m_batch_size			     { "batch_size", size_t(100) };
 		ReadOnly<size_t>			    m_batch_offset			     { "batch_offset", size_t(0) };
+		ReadOnly<bool>			        m_batch_prefetch		     { "batch_prefetch", bool(false) };
 		
 		ReadOnly<int>			    	m_features			     	 { "features", size_t(0),  false /* true? */ };
 		ReadOnly<int>			    	m_classes			     	 { "classes", size_t(0),  false /* true? */ };
@@ -43,6 +44,7 @@ namespace Denn
         ReadOnly<int>                   m_mask_reset_count           { "mask_reset_count",            int(-1),  true /* false? */ };
 
 		ReadOnly<unsigned int>	        m_seed                       { "seed", (unsigned int)(std::random_device{}())  };
+		ReadOnly<std::string>	        m_random_generator           { "random_generator", "mt19937" };
 
 		//intermedie results
 		ReadOnly<bool>        m_save_intermediate   		     { "save_intermediate",             bool(false), true /* false? */ };
@@ -67,6 +69,7 @@ namespace Denn
 		ReadOnly<Scalar>	             m_jde_cr        { "cr_jde", Scalar(0.1)   };
 		//JADE/SHADE/LSHADE
 		ReadOnly<size_t>	             m_archive_size { "archive_size", size_t(0) };
+		ReadOnly<std::string>	         m_archive_precision { "archive_precision", "float" };
 		ReadOnly<Scalar>	             m_f_cr_adapt   { "f_cr_adapt", Scalar(0.1) };
 		//SHADE/LSHADE
 		ReadOnly<size_t>	             m_shade_h      { "shade_h", size_t(10) };
@@ -97,6 +100,15 @@ namespace Denn
 		ReadOnly<Scalar>	             m_restart_delta { "restart_delta", Scalar(0.001) };
 		ReadOnly<size_t>	             m_threads_omp   { "threads_omp", size_t(2) };
 		ReadOnly<size_t>	             m_threads_pop   { "threads_pop", size_t(2) };
+		ReadOnly<std::string>	         m_activation_precision { "activation_precision", "exact" };
+		ReadOnly<size_t>	             m_population_batch { "population_batch", size_t(0) };
+		ReadOnly<bool>	                 m_population_arena { "population_arena", bool(false) };
+		ReadOnly<std::string>	         m_genome_precision { "genome_precision", "float" };
+		ReadOnly<size_t>	             m_im2col_cache_size { "im2col_cache_size", size_t(1) << 25 };
+		ReadOnly<bool>	                 m_prescreening        { "prescreening", bool(false) };
+		ReadOnly<Scalar>	             m_prescreening_margin { "prescreening_margin", Scalar(0.05) };
+		ReadOnly<std::string>	         m_prescreening_output { "prescreening_output", "" };
+		ReadOnly<bool>	                 m_fused_loss    { "fused_loss", bool(false) };
 		ReadOnly<size_t>	             m_history_size  { "history_size", size_t(1) };
 		//type of DE
 		ReadOnly<std::string>                m_mutation_type { "mutation","rand/1" };
@@ -43,6 +43,8 @@ namespace Denn
 
 		//copy
 		Population copy() const;
+		//copy in place, reuses the individuals already allocated
+		void copy_from(const Population& population);
 	
 		//as vector
 		std::vector < Individual::SPtr >& as_vector();
@@ -54,6 +56,26 @@ namespace Denn
 		bool m_minimize_loss_function { true };
 		friend class DoubleBufferPopulation;
 
+	};
+    ////////////////////////////////////////////////////////////////////////
+	//Pool of individuals, reuses the released ones (e.g. archives)
+	class IndividualPool
+	{
+	public:
+		//a copy of the individual
+		Individual::SPtr copy(const Individual& individual);
+		//a packed copy of the individual (see NeuralNetwork::copy_packed_from)
+		Individual::SPtr copy(const Individual& individual, GenomePrecision precision);
+		//give back individuals to the pool
+		void release(const Individual::SPtr& individual);
+		void release(const Population& population);
+		//free all
+		void clear();
+
+	protected:
+
+		std::vector < Individual::SPtr > m_individuals;
+
 	};
     ////////////////////////////////////////////////////////////////////////
 	enum class PopulationType : size_t
@@ -72,6 +94,12 @@ namespace Denn
         //attributes
 		Population m_pop_buffer[ size_t(PopulationType::PT_SIZE) ];
 		bool m_minimize_loss_function { true };
+		//arena, the genomes of parents and sons in a single buffer (a column for each individual)
+		Matrix m_arena;
+		//pool used by the crowding selection
+		ThreadPool* m_thread_pool { nullptr };
+		//storage of the genomes of parents and sons (fp16/bf16 = packed, see NeuralNetwork::genome_pack)
+		GenomePrecision m_genome_precision { GenomePrecision::GP_FLOAT };
 		//init population
 		void init(
 			  size_t np
@@ -81,6 +109,8 @@ namespace Denn
 			, Evaluation&		      loss_function
 			, ThreadPool*			  thread_pool = nullptr
 			, RandomFunctionThread    thread_random = nullptr
+			, bool                    use_arena = false
+			, GenomePrecision         precision = GenomePrecision::GP_FLOAT
 		);
 		//size
 		size_t size() const;
@@ -112,6 +142,8 @@ namespace Denn
 		void crowding_swap_list(std::vector<int> &list) const;
 		std::vector<int> parent_swap_list() const;
 		std::vector<int> crowding_swap_list() const;
+		//closest parent of each son
+		void crowding_closest_parents(std::vector<size_t> &closest) const;
 		//restart
 		void restart
 		(
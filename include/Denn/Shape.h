@@ -12,6 +12,8 @@ public:
 	}
 
 	explicit operator int() const { return size3D(); }
+	bool operator == (const Shape& shape) const { return m_width == shape.m_width && m_height == shape.m_height && m_channels == shape.m_channels; }
+	bool operator != (const Shape& shape) const { return !(*this == shape); }
 	int width() const { return m_width; }
 	int height() const { return m_height; }
 	int channels() const { return m_channels; }
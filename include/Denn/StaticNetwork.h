@@ -0,0 +1,195 @@
+#pragma once
+#include "Config.h"
+#include "NeuralNetwork.h"
+#include "Utilities/Transcendental.h"
+
+namespace Denn
+{
+	////////////////////////////////////////////////////////////////////////
+	//steps of a topology with static shapes
+	//fully_connected[OUT]
+	template < int OUT >
+	struct StaticFullyConnected
+	{
+		template < int IN >
+		static std::string topology()
+		{
+			return "fully_connected(" + std::to_string(IN) + "," + std::to_string(OUT) + ")";
+		}
+
+		template < int IN, typename Bottom >
+		static void apply(const Layer& layer, const Bottom& bottom, Eigen::Matrix< Scalar, OUT, Eigen::Dynamic >& top)
+		{
+			//W(IN x OUT), b(OUT x 1)
+			Eigen::Map< const Eigen::Matrix< Scalar, IN, OUT >, Eigen::Aligned > weight(layer[0].data());
+			Eigen::Map< const Eigen::Matrix< Scalar, OUT, 1 >, Eigen::Aligned > bias(layer[1].data());
+			// top = w' * x + b
+			top.resize(OUT, bottom.cols());
+			top.noalias() = weight.transpose() * bottom;
+			top.colwise() += bias;
+		}
+	};
+	//activations, in place (same functions of the layers)
+	struct StaticSigmoid
+	{
+		static const char* name() { return "sigmoid"; }
+
+		template < typename Data >
+		static void apply(Data& data)
+		{
+			Transcendental::sigmoid(data);
+		}
+	};
+	struct StaticTanh
+	{
+		static const char* name() { return "tanh"; }
+
+		template < typename Data >
+		static void apply(Data& data)
+		{
+			Transcendental::tanh(data);
+		}
+	};
+	struct StaticReLU
+	{
+		static const char* name() { return "relu"; }
+
+		template < typename Data >
+		static void apply(Data& data)
+		{
+			data = data.cwiseMax(Scalar(0.0));
+		}
+	};
+	struct StaticSoftmax
+	{
+		static const char* name() { return "softmax"; }
+
+		template < typename Data >
+		static void apply(Data& data)
+		{
+			RowVector z_max = data.colwise().maxCoeff();
+			if (Transcendental::exact())
+			{
+				data = (data.rowwise() - z_max).array().exp();
+			}
+			else
+			{
+				data.rowwise() -= z_max;
+				Transcendental::exp(data);
+			}
+			RowArray z_exp_sum = data.colwise().sum();
+			data.array().rowwise() /= z_exp_sum;
+		}
+	};
+	////////////////////////////////////////////////////////////////////////
+	//a step for each layer, ROWS = size of the input of the step
+	template < int ROWS, typename... Steps >
+	struct StaticPass;
+	//end, copy the output
+	template < int ROWS >
+	struct StaticPass< ROWS >
+	{
+		static std::string topology() { return std::string(); }
+
+		template < typename Data >
+		static void run(const NeuralNetwork&, size_t, Data& data, Matrix& output, bool logits)
+		{
+			output = data;
+		}
+	};
+	//fully connected, into a new buffer
+	template < int ROWS, int OUT, typename... Steps >
+	struct StaticPass< ROWS, StaticFullyConnected< OUT >, Steps... >
+	{
+		static std::string topology()
+		{
+			return " " + StaticFullyConnected< OUT >::template topology< ROWS >() + StaticPass< OUT, Steps... >::topology();
+		}
+
+		template < typename Data >
+		static void run(const NeuralNetwork& network, size_t layer, Data& data, Matrix& output, bool logits)
+		{
+			thread_local Eigen::Matrix< Scalar, OUT, Eigen::Dynamic > top;
+			StaticFullyConnected< OUT >::template apply< ROWS >(network[layer], data, top);
+			StaticPass< OUT, Steps... >::run(network, layer + 1, top, output, logits);
+		}
+	};
+	//activation, in place (logits = the last softmax is not applied)
+	template < int ROWS, typename Activation, typename... Steps >
+	struct StaticPass< ROWS, Activation, Steps... >
+	{
+		static constexpr bool last_softmax = sizeof...(Steps) == 0 && std::is_same< Activation, StaticSoftmax >::value;
+
+		static std::string topology()
+		{
+			return " " + std::string(Activation::name()) + "(" + std::to_string(ROWS) + "," + std::to_string(ROWS) + ")" + StaticPass< ROWS, Steps... >::topology();
+		}
+
+		template < typename Data >
+		static void run(const NeuralNetwork& network, size_t layer, Data& data, Matrix& output, bool logits)
+		{
+			if (!(logits && last_softmax)) Activation::apply(data);
+			StaticPass< ROWS, Steps... >::run(network, layer + 1, data, output, logits);
+		}
+	};
+	////////////////////////////////////////////////////////////////////////
+	//a network with static shapes (IN = features), the first step is a fully connected layer
+	//e.g. StaticNetwork< 30, StaticFullyConnected<50>, StaticSigmoid, StaticFullyConnected<2>, StaticSoftmax >
+	template < int IN, typename... Steps >
+	struct StaticNetwork
+	{
+		//the same string of StaticNetworkFactory::topology of a NeuralNetwork with this layout
+		static std::string topology()
+		{
+			return StaticPass< IN, Steps... >::topology().substr(1);
+		}
+
+		//logits = the output of the layer before the last softmax
+		static void predict(const NeuralNetwork& network, const Matrix& input, Matrix& output, bool logits)
+		{
+			Eigen::Map< const Eigen::Matrix< Scalar, IN, Eigen::Dynamic > > data(input.data(), IN, input.cols());
+			StaticPass< IN, Steps... >::run(network, 0, data, output, logits);
+		}
+	};
+	////////////////////////////////////////////////////////////////////////
+	//class factory of static networks
+	class StaticNetworkFactory
+	{
+
+	public:
+		//kernel of a topology (nullptr if it is not registered)
+		static NeuralNetwork::StaticPredict get(const NeuralNetwork& network);
+		static NeuralNetwork::StaticPredict get(const std::string& topology);
+		static void append(const std::string& topology, NeuralNetwork::StaticPredict predict);
+		//e.g. "fully_connected(30,50) sigmoid(50,50) fully_connected(50,2) softmax(2,2)"
+		static std::string topology(const NeuralNetwork& network);
+		//list of topologies
+		static std::vector< std::string > list_of_topologies();
+
+	};
+
+	//class used for static registration of a static network
+	template<class T>
+	class StaticNetworkItem
+	{
+		StaticNetworkItem()
+		{
+			StaticNetworkFactory::append(T::topology(), &T::predict);
+		}
+
+	public:
+
+		static StaticNetworkItem<T>& instance()
+		{
+			static StaticNetworkItem<T> objectItem;
+			return objectItem;
+		}
+
+	};
+
+	#define REGISTERED_STATIC_NETWORK(name_, ...)\
+	namespace\
+	{\
+		static const StaticNetworkItem< __VA_ARGS__ >& _Denn_ ## name_ ## _StaticNetworkItem = StaticNetworkItem< __VA_ARGS__ >::instance();\
+	}
+}
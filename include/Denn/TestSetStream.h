@@ -1,4 +1,5 @@
 #pragma once
+#include <future>
 #include "Config.h"
 #include "DataSet.h"
 #include "DataSetLoader.h"
@@ -15,18 +16,23 @@ namespace Denn
 		{
 		}
 
-		//start
-		void start_read_batch(size_t batch_size, size_t rows_offset);
+		//wait the prefetch
+		~TestSetStream();
 
-		//read
+		//start (prefetch = prepare the next batch on a background thread)
+		void start_read_batch(size_t batch_size, size_t rows_offset, bool prefetch = false);
+
+		//read (std::runtime_error if a batch is corrupt, also when it is read by the prefetch)
 		DataSetScalar& read_batch();
 
-		//get last
+		//get last (a ring buffer, the samples are rotated by batch_start())
 		const DataSetScalar& last_batch() const;
 
 		//info
 		size_t batch_size() const { return m_batch_size; }
 		size_t batch_offset() const { return m_batch_offset; }
+		bool   prefetch() const { return m_prefetch; }
+		size_t batch_start() const { return m_batch_start; }
 
 	protected:
 
@@ -36,10 +42,24 @@ namespace Denn
 
 		size_t			m_cache_cols_read;		//< ptr last row in cache
 		DataSetScalar	m_cache_batch;			//< cache 
-		DataSetScalar	m_batch;
+		DataSetViewScalar m_cache_view;			//< view of the cache (or of the mapped file)
+		DataSetScalar	m_batch;				//< ring buffer of samples
+		size_t			m_batch_start{ 0 };		//< column of the oldest sample
+		DataSetScalar	m_next_batch;			//< samples of the next batch
+		bool			m_prefetch{ false };	//< next batch is computed in background
+		std::future<void> m_next_ready;			//< prefetch task
+
+		//read the new samples into m_next_batch
+		void compute_next_batch(size_t n_cols_update);
+
+		//replace the oldest samples of the ring with m_next_batch
+		void push_next_batch();
+
+		//wait the prefetch task
+		void wait_next_batch();
 
-		//read
-		DataSetScalar& read_batch(size_t n_rows);
+		//read next batch of the dataset into the cache
+		void read_cache();
 
 	};
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "Denn/Config.h"
+
+namespace Denn
+{
+	//class of each sample (a column of the labels)
+	using ClassIndices = RowArrayT<int>;
+
+namespace internal
+{
+	//out[j] = row of the max of the column j (the first one, as maxCoeff)
+	//a pass for each row on all the columns, so the loop on the columns has no branches
+	template < typename ScalarType >
+	inline void colwise_argmax(const ScalarType* data, int rows, int cols, int stride, int* out)
+	{
+		thread_local RowArrayT<ScalarType> max_values;
+		max_values.resize(cols);
+		ScalarType* max = max_values.data();
+		for (int j = 0; j < cols; ++j)
+		{
+			max[j] = data[size_t(j) * stride];
+			out[j] = 0;
+		}
+		for (int r = 1; r < rows; ++r)
+		{
+			const ScalarType* row = data + r;
+			for (int j = 0; j < cols; ++j)
+			{
+				ScalarType value = row[size_t(j) * stride];
+				int mask = -int(value > max[j]);
+				out[j] = (r & mask) | (out[j] & ~mask);
+				max[j] = value > max[j] ? value : max[j];
+			}
+		}
+	}
+
+	template < typename Derived >
+	inline void colwise_argmax(const Eigen::DenseBase<Derived>& matrix, ClassIndices& out)
+	{
+		out.resize(matrix.cols());
+		if (!matrix.cols()) return;
+		colwise_argmax(matrix.derived().data(), int(matrix.rows()), int(matrix.cols()), int(matrix.derived().outerStride()), out.data());
+	}
+
+	//classes of one-hot labels, or of a single column of probabilities (y >= 0.5)
+	template < typename Derived >
+	inline void class_indices(const Eigen::DenseBase<Derived>& labels, ClassIndices& out)
+	{
+		using ScalarType = typename Derived::Scalar;
+		if (labels.rows() == 1) out = (labels.row(0).array() >= ScalarType(0.5)).template cast<int>();
+		else                    colwise_argmax(labels, out);
+	}
+
+} // namespace internal
+
+} // namespace Denn
@@ -1,5 +1,7 @@
 #pragma once
 #include "Denn/Config.h"
+#include <mutex>
+#include <atomic>
 
 namespace Denn 
 {
@@ -49,6 +51,20 @@ namespace internal
 			dim_out = height_out * width_out * channel_out;
 		}
 
+		//compare
+		bool operator == (const ConvDims& dim) const
+		{
+			return width_in      == dim.width_in
+				&& height_in     == dim.height_in
+				&& channel_in    == dim.channel_in
+				&& width_kernel  == dim.width_kernel
+				&& height_kernel == dim.height_kernel
+				&& channel_out   == dim.channel_out
+				&& stride        == dim.stride
+				&& pad_w         == dim.pad_w
+				&& pad_h         == dim.pad_h;
+		}
+
 		int in_image_size() const
 		{
 			return height_in * width_in;
@@ -80,27 +96,34 @@ namespace internal
 		}
 	};
 
-	inline void img_to_col
+	//im2col into a block of rows (hw_out x kernel_size) of a bigger matrix
+	template < typename Block >
+	inline void img_to_col_block
 	(
 		const ConvDims& dim,
 		RefConstColVector image,
-		Matrix& data_col
+		Block&& data_col
 	)
 	{
 		int hw_in = dim.in_image_size();
 		int hw_kernel = dim.on_channel_kernel_size();
 		int hw_out = dim.out_image_size();
-		// im2col
-		data_col.resize(hw_out, hw_kernel * dim.channel_in);
+		//1x1 kernel (pointwise), the image is already lowered (hw x channels)
+		if (hw_kernel == 1 && dim.stride == 1 && !dim.pad_w && !dim.pad_h)
+		{
+			data_col = Eigen::Map< const Matrix >(image.data(), hw_in, dim.channel_in);
+			return;
+		}
+		//column by column (contiguous writes)
 		for (int c = 0; c < dim.channel_in; c++) 
 		{
-			for (int i = 0; i < hw_out; i++) 
+			for (int j = 0; j < hw_kernel; j++) 
 			{
-				int step_h = i / dim.width_out;
-				int step_w = i % dim.width_out;
-				int start_idx = step_h * dim.width_in * dim.stride + step_w * dim.stride;  // left-top idx of window
-				for (int j = 0; j < hw_kernel; j++) 
+				for (int i = 0; i < hw_out; i++) 
 				{
+					int step_h = i / dim.width_out;
+					int step_w = i % dim.width_out;
+					int start_idx = step_h * dim.width_in * dim.stride + step_w * dim.stride;  // left-top idx of window
 					int cur_col = start_idx % dim.width_in + j % dim.width_kernel - dim.pad_w;  // col after padding
 					int cur_row = start_idx / dim.width_in + j / dim.width_kernel - dim.pad_h;
 					if (cur_col < 0 || cur_col >= dim.width_in || cur_row < 0 || cur_row >= dim.height_in)
@@ -109,7 +132,6 @@ namespace internal
 					}
 					else 
 					{
-						//int pick_idx = start_idx + (j / width_kernel) * width_in + j % width_kernel;
 						int pick_idx = cur_row * dim.width_in + cur_col;
 						data_col(i, c * hw_kernel + j) = image(hw_in * c + pick_idx);
 					}
@@ -118,6 +140,36 @@ namespace internal
 		}
 	}
 
+	//im2col of the samples [start, start + count) of a batch, stacked by rows ((count * hw_out) x kernel_size)
+	inline void img_to_col
+	(
+		const ConvDims& dim,
+		const Matrix& images,
+		int start,
+		int count,
+		Matrix& data_col
+	)
+	{
+		int hw_out = dim.out_image_size();
+		data_col.resize(hw_out * count, dim.kernel_size());
+		for (int s = 0; s < count; ++s)
+		{
+			img_to_col_block(dim, images.col(start + s), data_col.middleRows(s * hw_out, hw_out));
+		}
+	}
+
+	//im2col of a sample
+	inline void img_to_col
+	(
+		const ConvDims& dim,
+		RefConstColVector image,
+		Matrix& data_col
+	)
+	{
+		data_col.resize(dim.out_image_size(), dim.kernel_size());
+		img_to_col_block(dim, image, data_col);
+	}
+
 	inline void col_to_img(const ConvDims& dim, const Matrix& data_col, RefColVector image)
 	{
 		int hw_in = dim.in_image_size();
@@ -152,6 +204,36 @@ namespace internal
 			}
 		}
 	}
+
+	//im2col of an input shared by all the networks (the batch, the validation/test set),
+	//owned by the dataset (see DataSet::im2col_cache), computed once for each content and read by all the first convolutional layers
+	class Im2ColCache
+	{
+	public:
+		//an empty cache, a copy does not share the lowered input
+		Im2ColCache();
+		Im2ColCache(const Im2ColCache&);
+		Im2ColCache& operator = (const Im2ColCache&);
+		//max size (values) of a lowered input, the samples over it are not cached
+		static size_t max_size();
+		static void max_size(size_t size);
+		//the values of the input are changed
+		void update();
+		//lowered input ((samples * hw_out) x kernel_size) of the first samples that fit max_size, nullptr if none fits
+		std::shared_ptr<const Matrix> get(const ConvDims& dim, const Matrix& input);
+		//unique id of the current values of the input
+		size_t revision() const { return m_revision; }
+	protected:
+		struct Lowered
+		{
+			ConvDims				 m_dim;
+			size_t					 m_revision{ 0 };
+			std::shared_ptr<Matrix>  m_data;
+		};
+		std::atomic<size_t>  m_revision;
+		std::vector<Lowered> m_lowered;
+		std::mutex			 m_mutex;
+	};
 } // namespace internal
 
 } // namespace Denn
@@ -0,0 +1,98 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Utilities/Convolution.h"
+#include "Denn/Utilities/Pooling.h"
+
+namespace Denn
+{
+
+namespace internal
+{
+	//depthwise conv of a plane, K x K window, stride S (all windows inside), row by row
+	template < int K, int S >
+	inline void depthwise_plane
+	(
+		const ConvDims& dim,
+		const Scalar* in,
+		const Scalar* kernel,
+		Scalar bias,
+		Scalar* out
+	)
+	{
+		const int width_in = dim.width_in;
+		const int width_out = dim.width_out;
+		for (int y = 0; y < dim.height_out; ++y)
+		{
+			Scalar* out_row = out + y * width_out;
+			for (int x = 0; x < width_out; ++x) out_row[x] = bias;
+			//window element by element, over the whole output row
+			for (int ky = 0; ky < K; ++ky)
+			for (int kx = 0; kx < K; ++kx)
+			{
+				const Scalar weight = kernel[ky * K + kx];
+				const Scalar* in_row = in + (y * S + ky) * width_in + kx;
+				for (int x = 0; x < width_out; ++x) out_row[x] += weight * in_row[x * S];
+			}
+		}
+	}
+
+	//depthwise conv of a plane, any window and padding, by table
+	inline void depthwise_plane
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Scalar* in,
+		const Scalar* kernel,
+		Scalar bias,
+		Scalar* out
+	)
+	{
+		int hw_pool = dim.pool_size();
+		int hw_out = dim.out_image_size();
+		const int* window = table.m_index.data();
+		for (int i_out = 0; i_out < hw_out; ++i_out, window += hw_pool)
+		{
+			Scalar sum = bias;
+			for (int i_pool = 0; i_pool < hw_pool; ++i_pool)
+			{
+				if (window[i_pool] < 0) continue;  // padding
+				sum += kernel[i_pool] * in[window[i_pool]];
+			}
+			out[i_out] = sum;
+		}
+	}
+
+	//depthwise conv of a batch (each column is a sample of channel_in planes)
+	//kernels = hw_pool x channel_in (a kernel for each channel), bias = channel_in
+	inline void depthwise_convolution
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Scalar* kernels,
+		const Scalar* bias,
+		const Matrix& bottom,
+		Matrix& top
+	)
+	{
+		int hw_in = dim.in_image_size();
+		int hw_pool = dim.pool_size();
+		int hw_out = dim.out_image_size();
+		int n_sample = bottom.cols();
+		//all the planes of the batch
+		for (int i = 0; i < n_sample; ++i)
+		for (int c = 0; c < dim.channel_in; ++c)
+		{
+			const Scalar* in = bottom.col(i).data() + c * hw_in;
+			const Scalar* kernel = kernels + c * hw_pool;
+			Scalar* out = top.col(i).data() + c * hw_out;
+			//common cases
+			if (table.specialized(dim, 3, 1))      depthwise_plane<3, 1>(dim, in, kernel, bias[c], out);
+			else if (table.specialized(dim, 3, 2)) depthwise_plane<3, 2>(dim, in, kernel, bias[c], out);
+			else if (table.specialized(dim, 5, 1)) depthwise_plane<5, 1>(dim, in, kernel, bias[c], out);
+			else                                   depthwise_plane(dim, table, in, kernel, bias[c], out);
+		}
+	}
+
+} // namespace internal
+
+} // namespace Denn
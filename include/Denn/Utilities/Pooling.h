@@ -0,0 +1,237 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Utilities/Convolution.h"
+
+namespace Denn
+{
+
+namespace internal
+{
+	//index of the elements of each window (hw_out x hw_pool), -1 = out of range
+	struct PoolingTable
+	{
+		std::vector<int> m_index;
+		bool			 m_full{ true }; //all windows inside the image
+
+		void init(const ConvDims& dim)
+		{
+			int hw_pool = dim.pool_size();
+			int hw_out = dim.out_image_size();
+			m_index.resize(size_t(hw_out) * hw_pool);
+			m_full = true;
+			for (int i_out = 0; i_out < hw_out; i_out++)
+			{
+				int step_h = i_out / dim.width_out;
+				int step_w = i_out % dim.width_out;
+				// left-top of window in raw image (padding = outside)
+				int start_x = step_w * dim.stride - dim.pad_w;
+				int start_y = step_h * dim.stride - dim.pad_h;
+				for (int i_pool = 0; i_pool < hw_pool; i_pool++)
+				{
+					int x = start_x + i_pool % dim.width_kernel;
+					int y = start_y + i_pool / dim.width_kernel;
+					bool inside = 0 <= x && x < dim.width_in && 0 <= y && y < dim.height_in;
+					m_index[size_t(i_out) * hw_pool + i_pool] = inside ? y * dim.width_in + x : -1;
+					m_full &= inside;
+				}
+			}
+		}
+
+		//a specialized kernel can be used (square window, all windows inside)
+		bool specialized(const ConvDims& dim, int kernel, int stride) const
+		{
+			return m_full
+				&& dim.width_kernel == kernel
+				&& dim.height_kernel == kernel
+				&& dim.stride == stride;
+		}
+	};
+
+	//max pooling of a plane, K x K window, stride S, row by row (the last max wins, as >=)
+	template < int K, int S, bool INDEX >
+	inline void max_pooling_plane
+	(
+		const ConvDims& dim,
+		const Scalar* in,
+		Scalar* out,
+		int* index,
+		int index_offset
+	)
+	{
+		const int width_in = dim.width_in;
+		const int width_out = dim.width_out;
+		for (int y = 0; y < dim.height_out; ++y)
+		{
+			Scalar* out_row = out + y * width_out;
+			int* index_row = INDEX ? index + y * width_out : nullptr;
+			for (int x = 0; x < width_out; ++x) out_row[x] = std::numeric_limits<Scalar>::lowest();
+			//window element by element, over the whole output row
+			for (int ky = 0; ky < K; ++ky)
+			for (int kx = 0; kx < K; ++kx)
+			{
+				const int row_idx = (y * S + ky) * width_in + kx;
+				const Scalar* in_row = in + row_idx;
+				for (int x = 0; x < width_out; ++x)
+				{
+					const Scalar value = in_row[x * S];
+					const bool take = value >= out_row[x];
+					out_row[x] = take ? value : out_row[x];
+					if (INDEX) index_row[x] = take ? index_offset + row_idx + x * S : index_row[x];
+				}
+			}
+		}
+	}
+
+	//avg pooling of a plane, K x K window, stride S, row by row
+	template < int K, int S >
+	inline void avg_pooling_plane
+	(
+		const ConvDims& dim,
+		const Scalar* in,
+		Scalar* out
+	)
+	{
+		const int width_in = dim.width_in;
+		const int width_out = dim.width_out;
+		const Scalar hw_pool = Scalar(K * K);
+		for (int y = 0; y < dim.height_out; ++y)
+		{
+			Scalar* out_row = out + y * width_out;
+			for (int x = 0; x < width_out; ++x) out_row[x] = Scalar(0);
+			//window element by element, over the whole output row
+			for (int ky = 0; ky < K; ++ky)
+			for (int kx = 0; kx < K; ++kx)
+			{
+				const Scalar* in_row = in + (y * S + ky) * width_in + kx;
+				for (int x = 0; x < width_out; ++x) out_row[x] += in_row[x * S];
+			}
+			for (int x = 0; x < width_out; ++x) out_row[x] /= hw_pool;
+		}
+	}
+
+	//max pooling of a plane, any window, by table
+	template < bool INDEX >
+	inline void max_pooling_plane
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Scalar* in,
+		Scalar* out,
+		int* index,
+		int index_offset
+	)
+	{
+		int hw_pool = dim.pool_size();
+		int hw_out = dim.out_image_size();
+		const int* window = table.m_index.data();
+		for (int i_out = 0; i_out < hw_out; ++i_out, window += hw_pool)
+		{
+			Scalar max_value = std::numeric_limits<Scalar>::lowest();
+			for (int i_pool = 0; i_pool < hw_pool; ++i_pool)
+			{
+				if (window[i_pool] < 0) continue;  // out of range
+				if (in[window[i_pool]] >= max_value)
+				{
+					max_value = in[window[i_pool]];
+					if (INDEX) index[i_out] = index_offset + window[i_pool];
+				}
+			}
+			out[i_out] = max_value;
+		}
+	}
+
+	//avg pooling of a plane, any window, by table
+	inline void avg_pooling_plane
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Scalar* in,
+		Scalar* out
+	)
+	{
+		int hw_pool = dim.pool_size();
+		int hw_out = dim.out_image_size();
+		const int* window = table.m_index.data();
+		for (int i_out = 0; i_out < hw_out; ++i_out, window += hw_pool)
+		{
+			Scalar sum = Scalar(0);
+			for (int i_pool = 0; i_pool < hw_pool; ++i_pool)
+			{
+				if (window[i_pool] < 0) continue;  // out of range
+				sum += in[window[i_pool]];
+			}
+			out[i_out] = sum / Scalar(hw_pool);
+		}
+	}
+
+	//max pooling of a sample (channel_in planes), index = max position for each output
+	template < bool INDEX >
+	inline void max_pooling_sample
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Scalar* image,
+		Scalar* top,
+		int* index
+	)
+	{
+		int hw_in = dim.in_image_size();
+		int hw_out = dim.out_image_size();
+		for (int c = 0; c < dim.channel_in; ++c)
+		{
+			const Scalar* in = image + c * hw_in;
+			Scalar* out = top + c * hw_out;
+			int* out_index = INDEX ? index + c * hw_out : nullptr;
+			//common cases
+			if (table.specialized(dim, 2, 2))      max_pooling_plane<2, 2, INDEX>(dim, in, out, out_index, c * hw_in);
+			else if (table.specialized(dim, 3, 2)) max_pooling_plane<3, 2, INDEX>(dim, in, out, out_index, c * hw_in);
+			else                                   max_pooling_plane<INDEX>(dim, table, in, out, out_index, c * hw_in);
+		}
+	}
+
+	//max pooling of a batch (each column is a sample of channel_in planes), index = max position for each output of each sample
+	template < bool INDEX >
+	inline void max_pooling
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Matrix& bottom,
+		Matrix& top,
+		std::vector< std::vector<int> >* index
+	)
+	{
+		//all the planes of the batch
+		for (int i = 0; i < bottom.cols(); ++i)
+		{
+			max_pooling_sample<INDEX>(dim, table, bottom.col(i).data(), top.col(i).data(), INDEX ? (*index)[i].data() : nullptr);
+		}
+	}
+
+	//avg pooling of a batch (each column is a sample of channel_in planes)
+	inline void avg_pooling
+	(
+		const ConvDims& dim,
+		const PoolingTable& table,
+		const Matrix& bottom,
+		Matrix& top
+	)
+	{
+		int hw_in = dim.in_image_size();
+		int hw_out = dim.out_image_size();
+		int n_sample = bottom.cols();
+		//all the planes of the batch
+		for (int i = 0; i < n_sample; ++i)
+		for (int c = 0; c < dim.channel_in; ++c)
+		{
+			const Scalar* in = bottom.col(i).data() + c * hw_in;
+			Scalar* out = top.col(i).data() + c * hw_out;
+			//common cases
+			if (table.specialized(dim, 2, 2))      avg_pooling_plane<2, 2>(dim, in, out);
+			else if (table.specialized(dim, 3, 2)) avg_pooling_plane<3, 2>(dim, in, out);
+			else                                   avg_pooling_plane(dim, table, in, out);
+		}
+	}
+
+} // namespace internal
+
+} // namespace Denn
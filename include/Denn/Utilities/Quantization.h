@@ -0,0 +1,125 @@
+#pragma once
+#include "Denn/Config.h"
+
+namespace Denn
+{
+
+namespace internal
+{
+	//int8 values of a buffer, q = round(x / scale)
+	inline void quantize_values(const Scalar* in, int size, Scalar inv_scale, int16_t* out)
+	{
+		for (int i = 0; i < size; ++i)
+		{
+			Scalar value = in[i] * inv_scale;
+			out[i] = int16_t(int32_t(value + (value >= Scalar(0) ? Scalar(0.5) : Scalar(-0.5))));
+		}
+	}
+
+	//scale of a max |x|, max |x| -> 127
+	inline Scalar quantization_scale(Scalar max_abs)
+	{
+		return max_abs > Scalar(0) ? max_abs / Scalar(127) : Scalar(1);
+	}
+
+	//int8 matrix, symmetric quantization of each column (value ~ q * scale)
+	//the values are stored widened to 16 bits, so the products are int16 multiply-adds
+	struct QuantizedMatrix
+	{
+		using ConstMapColumn = Eigen::Map< const ColVector >;
+
+		int					 m_rows{ 0 };
+		int					 m_cols{ 0 };
+		std::vector<int16_t> m_values;
+		std::vector<Scalar>  m_scales;
+
+		//a scale for each column (column major, stride = distance between the columns)
+		void quantize(const Scalar* data, int rows, int cols, int stride)
+		{
+			m_rows = rows;
+			m_cols = cols;
+			m_values.resize(size_t(m_rows) * m_cols);
+			m_scales.resize(size_t(m_cols));
+			for (int c = 0; c < cols; ++c)
+			{
+				ConstMapColumn column(data + size_t(c) * stride, rows);
+				m_scales[c] = quantization_scale(rows ? column.cwiseAbs().maxCoeff() : Scalar(0));
+				quantize_values(column.data(), rows, Scalar(1) / m_scales[c], m_values.data() + size_t(c) * m_rows);
+			}
+		}
+
+		//matrix with direct access (matrix, map, block of columns/rows)
+		template < typename Derived >
+		void quantize(const Eigen::DenseBase<Derived>& matrix)
+		{
+			quantize(matrix.derived().data(), int(matrix.rows()), int(matrix.cols()), int(matrix.derived().outerStride()));
+		}
+
+		const int16_t* col(int c) const { return m_values.data() + size_t(c) * m_rows; }
+	};
+
+	//4 x 2 block of dot products (columns a[0..3] by columns b[0..1]), int32 accumulators
+	inline void quantized_block_4x2(const int16_t* const a[4], const int16_t* const b[2], int size, int32_t out[8])
+	{
+		int32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0, t0 = 0, t1 = 0, t2 = 0, t3 = 0;
+		for (int k = 0; k < size; ++k)
+		{
+			int32_t x = b[0][k], y = b[1][k];
+			s0 += a[0][k] * x; s1 += a[1][k] * x; s2 += a[2][k] * x; s3 += a[3][k] * x;
+			t0 += a[0][k] * y; t1 += a[1][k] * y; t2 += a[2][k] * y; t3 += a[3][k] * y;
+		}
+		out[0] = s0; out[1] = s1; out[2] = s2; out[3] = s3;
+		out[4] = t0; out[5] = t1; out[6] = t2; out[7] = t3;
+	}
+
+	//a dot product, int32 accumulator
+	inline int32_t quantized_dot(const int16_t* a, const int16_t* b, int size)
+	{
+		int32_t sum = 0;
+		for (int k = 0; k < size; ++k) sum += int32_t(a[k]) * int32_t(b[k]);
+		return sum;
+	}
+
+	//out = a' * b, out(i, j) = dot(a.col(i), b.col(j)) * scale_a(i) * scale_b(j)
+	inline void quantized_product(const QuantizedMatrix& a, const QuantizedMatrix& b, Matrix& out)
+	{
+		denn_assert(a.m_rows == b.m_rows);
+		const int size = a.m_rows;
+		const int n_i = a.m_cols;
+		const int n_j = b.m_cols;
+		out.resize(n_i, n_j);
+		//blocks of 4 x 2 outputs
+		int j = 0;
+		for (; j + 2 <= n_j; j += 2)
+		{
+			const int16_t* b_cols[2] = { b.col(j), b.col(j + 1) };
+			int i = 0;
+			for (; i + 4 <= n_i; i += 4)
+			{
+				const int16_t* a_cols[4] = { a.col(i), a.col(i + 1), a.col(i + 2), a.col(i + 3) };
+				int32_t block[8];
+				quantized_block_4x2(a_cols, b_cols, size, block);
+				for (int r = 0; r < 4; ++r)
+				{
+					out(i + r, j)	  = Scalar(block[r])	 * (a.m_scales[i + r] * b.m_scales[j]);
+					out(i + r, j + 1) = Scalar(block[4 + r]) * (a.m_scales[i + r] * b.m_scales[j + 1]);
+				}
+			}
+			//last rows
+			for (; i < n_i; ++i)
+			{
+				out(i, j)	  = Scalar(quantized_dot(a.col(i), b_cols[0], size)) * (a.m_scales[i] * b.m_scales[j]);
+				out(i, j + 1) = Scalar(quantized_dot(a.col(i), b_cols[1], size)) * (a.m_scales[i] * b.m_scales[j + 1]);
+			}
+		}
+		//last column
+		for (; j < n_j; ++j)
+		for (int i = 0; i < n_i; ++i)
+		{
+			out(i, j) = Scalar(quantized_dot(a.col(i), b.col(j), size)) * (a.m_scales[i] * b.m_scales[j]);
+		}
+	}
+
+} // namespace internal
+
+} // namespace Denn
@@ -0,0 +1,60 @@
+#pragma once
+#include "Denn/Config.h"
+#include "Denn/Utilities/Transcendental.h"
+#include "Denn/Utilities/ArgMax.h"
+
+namespace Denn
+{
+
+namespace internal
+{
+	//log(sum(exp(z))) of a column, shifted by the max
+	template < typename Column >
+	inline Scalar log_sum_exp(const Column& z)
+	{
+		Scalar z_max = z.maxCoeff();
+		if (Transcendental::exact())
+		{
+			return z_max + std::log((z.array() - z_max).exp().sum());
+		}
+		//fast kernels, on a buffer of a column
+		thread_local ColVector z_exp;
+		z_exp = z.array() - z_max;
+		Transcendental::exp(z_exp);
+		return z_max + std::log(z_exp.sum());
+	}
+
+	//sum over the samples of -y' log(softmax(z)) = sum(y) * log(sum(exp(z))) - y' z, without the probabilities
+	inline Scalar softmax_cross_entropy(const Matrix& logits, const Matrix& target)
+	{
+		denn_assert(logits.rows() == target.rows() && logits.cols() == target.cols());
+		Scalar loss = Scalar(0);
+		for (Matrix::Index j = 0; j < logits.cols(); ++j)
+		{
+			loss += log_sum_exp(logits.col(j)) * target.col(j).sum() - target.col(j).dot(logits.col(j));
+		}
+		return loss;
+	}
+
+	//one-hot labels as classes, sum over the samples of log(sum(exp(z))) - z[class]
+	inline Scalar softmax_cross_entropy(const Matrix& logits, const ClassIndices& classes)
+	{
+		denn_assert(logits.cols() == classes.size());
+		Scalar loss = Scalar(0);
+		for (Matrix::Index j = 0; j < logits.cols(); ++j)
+		{
+			loss += log_sum_exp(logits.col(j)) - logits(classes(j), j);
+		}
+		return loss;
+	}
+
+	//d(L)/d(z) of the mean loss = (softmax(z) * sum(y) - y) / n, from the output of the softmax
+	inline void softmax_cross_entropy_gradient(const Matrix& softmax, const Matrix& target, Matrix& grad)
+	{
+		RowArray target_sum = target.colwise().sum();
+		grad = (softmax.array().rowwise() * target_sum - target.array()) / Scalar(softmax.cols());
+	}
+
+} // namespace internal
+
+} // namespace Denn
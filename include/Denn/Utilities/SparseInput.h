@@ -0,0 +1,84 @@
+#pragma once
+#include "Denn/Config.h"
+
+namespace Denn
+{
+
+namespace internal
+{
+	//sparse features of a dataset, the dense features of a sparse dataset are an empty placeholder (0 x samples)
+	//only the features of Scalar type are inputs of the networks
+	template < typename T >
+	inline const SparseMatrix* sparse_input(const MatrixT<T>& placeholder, const SparseMatrixT<T>& features) { return nullptr; }
+
+	inline const SparseMatrix* sparse_input(const Matrix& placeholder, const SparseMatrix& features)
+	{
+		return !placeholder.rows() && features.rows() && features.cols() == placeholder.cols() ? &features : nullptr;
+	}
+
+	//appends the columns [start, start + count) of in to out, out is built column by column (see finalize)
+	template < typename ScalarType >
+	inline void sparse_append_cols(const SparseMatrixT<ScalarType>& in, int start, int count, SparseMatrixT<ScalarType>& out, int& out_col)
+	{
+		using InnerIterator = typename SparseMatrixT<ScalarType>::InnerIterator;
+		for (int j = start; j < start + count; ++j, ++out_col)
+		{
+			out.startVec(out_col);
+			for (InnerIterator it(in, j); it; ++it) out.insertBack(it.row(), out_col) = it.value();
+		}
+	}
+
+	//end of the column j, x can be uncompressed (a column can have free room, see TestSetStream)
+	inline int sparse_col_end(const SparseMatrix& x, int j)
+	{
+		const int* nnz = x.innerNonZeroPtr();
+		return nnz ? x.outerIndexPtr()[j] + nnz[j] : x.outerIndexPtr()[j + 1];
+	}
+
+	//top = w' * x + b, x sparse (features x samples), w dense (features x outputs)
+	//an output at time, so a column of w is read for all the samples
+	template < typename Weight, typename Bias >
+	inline void sparse_fully_connected(const SparseMatrix& x, const Weight& weight, const Bias& bias, Matrix& top)
+	{
+		const int n_sample = int(x.cols());
+		const int n_out = int(weight.cols());
+		const int* outer = x.outerIndexPtr();
+		const int* inner = x.innerIndexPtr();
+		const Scalar* values = x.valuePtr();
+		top.resize(n_out, n_sample);
+		for (int o = 0; o < n_out; ++o)
+		{
+			const Scalar* w = weight.col(o).data();
+			for (int j = 0; j < n_sample; ++j)
+			{
+				Scalar sum = bias(o);
+				for (int k = outer[j], end = sparse_col_end(x, j); k < end; ++k) sum += values[k] * w[inner[k]];
+				top(o, j) = sum;
+			}
+		}
+	}
+
+	//grad_w = x * grad', x sparse (features x samples), grad dense (outputs x samples)
+	template < typename GradWeight >
+	inline void sparse_fully_connected_gradient(const SparseMatrix& x, const Matrix& grad, GradWeight& grad_w)
+	{
+		const int n_sample = int(x.cols());
+		const int n_out = int(grad.rows());
+		const int* outer = x.outerIndexPtr();
+		const int* inner = x.innerIndexPtr();
+		const Scalar* values = x.valuePtr();
+		grad_w.setZero();
+		for (int o = 0; o < n_out; ++o)
+		{
+			Scalar* gw = grad_w.col(o).data();
+			for (int j = 0; j < n_sample; ++j)
+			{
+				const Scalar g = grad(o, j);
+				for (int k = outer[j], end = sparse_col_end(x, j); k < end; ++k) gw[inner[k]] += values[k] * g;
+			}
+		}
+	}
+
+} // namespace internal
+
+} // namespace Denn
@@ -0,0 +1,247 @@
+#pragma once
+#include "Denn/Config.h"
+#include <Eigen/Core>
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+namespace Denn
+{
+	//accuracy of exp/log/tanh of the activations and of the evaluations
+	//(max error measured on all the floats of the clamped ranges, against double)
+	enum class TranscendentalPrecision
+	{
+		TP_EXACT,  //Eigen/std functions
+		TP_FAST,   //polynomials, <= 2.5 ulp (sigmoid, 1.5e-7 relative), exp/log/tanh <= 1.4 ulp
+		TP_APPROX  //short polynomials, <= 5.6e-5 relative error
+	};
+
+	inline bool transcendental_precision_from_string(const std::string& name, TranscendentalPrecision& precision)
+	{
+		if (name == "exact")  { precision = TranscendentalPrecision::TP_EXACT;  return true; }
+		if (name == "fast")   { precision = TranscendentalPrecision::TP_FAST;   return true; }
+		if (name == "approx") { precision = TranscendentalPrecision::TP_APPROX; return true; }
+		return false;
+	}
+
+	//global setting (as Eigen::setNbThreads), set before the execution
+	inline TranscendentalPrecision& transcendental_precision()
+	{
+		static TranscendentalPrecision precision{ TranscendentalPrecision::TP_EXACT };
+		return precision;
+	}
+
+namespace internal
+{
+	//the loops are branchless, so they are vectorized by the compiler (float x 4 with sse2),
+	//the ranges are clamped by a separate pass (a clamp in the same loop is turned into branches)
+	inline int32_t scalar_bits(float value)
+	{
+		int32_t bits;
+		std::memcpy(&bits, &value, sizeof(bits));
+		return bits;
+	}
+
+	inline float bits_scalar(int32_t bits)
+	{
+		float value;
+		std::memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+
+	//a nan is not clamped (nan = worst fitness)
+	inline void clamp_values(const float* in, float* out, size_t size, float min, float max)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			float x = in[i] > max ? max : in[i];
+			out[i] = x < min ? min : x;
+		}
+	}
+
+	//exp(x) = 2^n * exp(r), r in [-ln2/2, ln2/2], x in [EXP_MIN, EXP_MAX]
+	static const float EXP_MIN = -87.3365447504f;
+	static const float EXP_MAX = 88.3762626647949f;
+
+	template < bool FAST >
+	inline float exp_value(float x)
+	{
+		//n = round(x / ln2), by the magic number 1.5 * 2^23
+		float n = (x * 1.44269504088896341f + 12582912.0f) - 12582912.0f;
+		//r = x - n * ln2 (ln2 in two parts)
+		float r = x - n * 0.693359375f;
+		r = r - n * -2.12194440e-4f;
+		float p;
+		if (FAST)
+		{
+			//cephes expf
+			float z = r * r;
+			p = 1.9875691500E-4f;
+			p = p * r + 1.3981999507E-3f;
+			p = p * r + 8.3334519073E-3f;
+			p = p * r + 4.1665795894E-2f;
+			p = p * r + 1.6666665459E-1f;
+			p = p * r + 5.0000001201E-1f;
+			p = p * z + r + 1.0f;
+		}
+		else
+		{
+			//taylor, degree 4
+			p = 4.16666667E-2f;
+			p = p * r + 1.66666667E-1f;
+			p = p * r + 0.5f;
+			p = p * r + 1.0f;
+			p = p * r + 1.0f;
+		}
+		//2^n
+		return p * bits_scalar((int32_t(n) + 127) << 23);
+	}
+
+	//log(x) = e * ln2 + log(m), x in [LOG_MIN, inf) (x <= 0 -> log(LOG_MIN))
+	static const float LOG_MIN = 1.17549435e-38f;
+	static const float LOG_MAX = std::numeric_limits<float>::max();
+
+	template < bool FAST >
+	inline float log_value(float x)
+	{
+		//x = m * 2^e, m in [sqrt(1/2), sqrt(2)) (as musl, the offset moves the exponent if m >= sqrt(2))
+		int32_t bits = scalar_bits(x) + (0x3f800000 - 0x3f3504f3);
+		float e = float((bits >> 23) - 127);
+		float m = bits_scalar((bits & 0x007fffff) + 0x3f3504f3);
+		if (FAST)
+		{
+			//cephes logf
+			float f = m - 1.0f;
+			float z = f * f;
+			float p = 7.0376836292E-2f;
+			p = p * f - 1.1514610310E-1f;
+			p = p * f + 1.1676998740E-1f;
+			p = p * f - 1.2420140846E-1f;
+			p = p * f + 1.4249322787E-1f;
+			p = p * f - 1.6668057665E-1f;
+			p = p * f + 2.0000714765E-1f;
+			p = p * f - 2.4999993993E-1f;
+			p = p * f + 3.3333331174E-1f;
+			p = p * f * z;
+			p += e * -2.12194440e-4f;
+			p += -0.5f * z;
+			return f + p + e * 0.693359375f;
+		}
+		else
+		{
+			//log(m) = 2 * atanh(s), s = (m - 1) / (m + 1), |s| < 0.172
+			float s = (m - 1.0f) / (m + 1.0f);
+			float z = s * s;
+			float p = 0.2f;
+			p = p * z + 0.333333333f;
+			p = p * z + 1.0f;
+			return 2.0f * s * p + e * 0.693147180559945f;
+		}
+	}
+
+	//tanh(x) = sign(x) * (1 - 2 / (exp(2|x|) + 1)), polynomial near 0, x in [TANH_MIN, TANH_MAX] (tanh(9) = 1 in float)
+	static const float TANH_MIN = -9.0f;
+	static const float TANH_MAX = 9.0f;
+
+	template < bool FAST >
+	inline float tanh_value(float x)
+	{
+		float a = std::fabs(x);
+		float t = std::copysign(1.0f - 2.0f / (exp_value<FAST>(a + a) + 1.0f), x);
+		//cephes tanhf, |x| < 0.625 (also approx, the formula cancels near 0)
+		float z = x * x;
+		float p = -5.70498872745E-3f;
+		p = p * z + 2.06390887954E-2f;
+		p = p * z - 5.37397155531E-2f;
+		p = p * z + 1.33314422036E-1f;
+		p = p * z - 3.33332819422E-1f;
+		float small = x + x * z * p;
+		//select by mask
+		int32_t mask = -int32_t(a < 0.625f);
+		return bits_scalar((scalar_bits(small) & mask) | (scalar_bits(t) & ~mask));
+	}
+
+	//sigmoid(x) = 1 / (1 + exp(-x)), x in [SIGMOID_MIN, SIGMOID_MAX]
+	static const float SIGMOID_MIN = -EXP_MAX;
+	static const float SIGMOID_MAX = -EXP_MIN;
+
+	template < bool FAST >
+	inline float sigmoid_value(float x)
+	{
+		return 1.0f / (1.0f + exp_value<FAST>(-x));
+	}
+
+	//a kernel on a buffer (out can be in)
+	#define DENN_TRANSCENDENTAL_KERNEL(name_, min_, max_)\
+	template < bool FAST >\
+	inline void name_ ## _values(const float* in, float* out, size_t size)\
+	{\
+		clamp_values(in, out, size, min_, max_);\
+		for (size_t i = 0; i < size; ++i)\
+		{\
+			float x = out[i];\
+			int32_t nan = -int32_t(x != x);\
+			out[i] = bits_scalar((scalar_bits(x) & nan) | (scalar_bits(name_ ## _value<FAST>(x)) & ~nan));\
+		}\
+	}
+	DENN_TRANSCENDENTAL_KERNEL(exp, EXP_MIN, EXP_MAX)
+	DENN_TRANSCENDENTAL_KERNEL(log, LOG_MIN, LOG_MAX)
+	DENN_TRANSCENDENTAL_KERNEL(tanh, TANH_MIN, TANH_MAX)
+	DENN_TRANSCENDENTAL_KERNEL(sigmoid, SIGMOID_MIN, SIGMOID_MAX)
+	#undef DENN_TRANSCENDENTAL_KERNEL
+
+	//fast kernel of the current precision, false if it is exact (or Scalar is not float)
+	template < void (*FAST_KERNEL)(const float*, float*, size_t), void (*APPROX_KERNEL)(const float*, float*, size_t), typename T >
+	inline bool transcendental_kernel(const T* in, T* out, size_t size)
+	{
+		return false;
+	}
+	template < void (*FAST_KERNEL)(const float*, float*, size_t), void (*APPROX_KERNEL)(const float*, float*, size_t) >
+	inline bool transcendental_kernel(const float* in, float* out, size_t size)
+	{
+		switch (transcendental_precision())
+		{
+		case TranscendentalPrecision::TP_FAST:   FAST_KERNEL(in, out, size);   return true;
+		case TranscendentalPrecision::TP_APPROX: APPROX_KERNEL(in, out, size); return true;
+		default: return false;
+		}
+	}
+}
+
+namespace Transcendental
+{
+	//the fast kernels are disabled (exact precision, or Scalar is not float)
+	inline bool exact()
+	{
+		return transcendental_precision() == TranscendentalPrecision::TP_EXACT || !std::is_same< Scalar, float >::value;
+	}
+
+	//out = f(in), plain matrices (contiguous), out can be in
+	#define DENN_TRANSCENDENTAL_FUNCTION(name_, exact_)\
+	template < typename MatrixType >\
+	inline void name_(const MatrixType& in, MatrixType& out)\
+	{\
+		out.resize(in.rows(), in.cols());\
+		if (!internal::transcendental_kernel< internal::name_ ## _values<true>, internal::name_ ## _values<false> >(in.data(), out.data(), size_t(in.size())))\
+			out.noalias() = (exact_).matrix();\
+	}\
+	template < typename MatrixType >\
+	inline void name_(MatrixType& data)\
+	{\
+		name_(data, data);\
+	}
+	//exp(x)
+	DENN_TRANSCENDENTAL_FUNCTION(exp, in.array().exp())
+	//log(x)
+	DENN_TRANSCENDENTAL_FUNCTION(log, in.array().log())
+	//tanh(x)
+	DENN_TRANSCENDENTAL_FUNCTION(tanh, in.array().unaryExpr([](Scalar x) -> Scalar { return std::tanh(x); }))
+	//1 / (1 + exp(-x))
+	DENN_TRANSCENDENTAL_FUNCTION(sigmoid, Scalar(1.0) / (Scalar(1.0) + (-in).array().exp()))
+	#undef DENN_TRANSCENDENTAL_FUNCTION
+}
+
+}
@@ -18,6 +18,7 @@ namespace Denn
 	    , *params.m_perc_of_best
 		, instance.neural_network()
 		))
+	, m_instance(instance)
 	, m_dataset_loader(&instance.dataset_loader())
 	, m_dataset_batch(&instance.dataset_loader())
 	, m_params(params)
@@ -31,9 +32,9 @@ namespace Denn
 		bool success = m_dataset_loader != nullptr;
 		//init test set
 		if(*m_params.m_batch_offset <= 0)
-			m_dataset_batch.start_read_batch(*m_params.m_batch_size, *m_params.m_batch_size);
+			m_dataset_batch.start_read_batch(*m_params.m_batch_size, *m_params.m_batch_size, *m_params.m_batch_prefetch);
 		else
-			m_dataset_batch.start_read_batch(*m_params.m_batch_size, *m_params.m_batch_offset);
+			m_dataset_batch.start_read_batch(*m_params.m_batch_size, *m_params.m_batch_offset, *m_params.m_batch_prefetch);
 		//init random engine
 		m_main_random.reinit(*m_params.m_seed);
 		//gen clamp functions
@@ -50,10 +51,13 @@ namespace Denn
 		size_t np = (size_t)m_params.m_np; //init current_np();
 		//min size
 		if (!np) return false;
+		//storage of the genomes
+		GenomePrecision precision = GenomePrecision::GP_FLOAT;
+		genome_precision_from_string(*m_params.m_genome_precision, precision);
 		//init random engines
 		for(size_t i=0; i != np ;++i)
 		{
-			m_population_random.emplace_back(main_random().uirand());
+			m_population_random.emplace_back(main_random().uirand(), main_random().generator());
 		}
 		//init pop
 		m_population.init
@@ -65,6 +69,8 @@ namespace Denn
 			, *m_loss_function
 			,  m_thpool
 			,  gen_random_func_thread()
+			, *m_params.m_population_arena
+			,  precision
 		);
 		//method of evoluction
 		m_e_method = EvolutionMethodFactory::create(m_params.m_evolution_type, *this);
@@ -85,6 +91,8 @@ namespace Denn
 		const size_t n_sub_pass = m_params.m_sub_gens;
 		//restart init
 		m_restart_ctx = RestartContext();
+		//pre-screening stats, the int8 pass of a convolutional network costs as much as the exact one
+		m_prescreening_ctx.reset(*m_params.m_prescreening && m_default->m_network.quantizable());
 		//best
 		Scalar worst_eval = m_e_method->best_from_validation() 
 						          ? validation_function_worst() 
@@ -126,24 +134,53 @@ namespace Denn
 	//using the test set on a individual
 	Scalar DennAlgorithm::execute_test() const 
 	{
-		//validation
-		DataSetScalar test;
-		m_dataset_loader->read_test(test);
 		//compute test
-		Scalar eval = (*m_test_function)((NeuralNetwork&)*m_best_ctx.m_best, test);
+		Scalar eval = execute_on_shards(*m_test_function, m_best_ctx.m_best->m_network);
 		//return
 		return eval;
 	}
 	Scalar DennAlgorithm::execute_test(Individual& individual) const 
 	{
-		//validation
-		DataSetScalar test;
-		m_dataset_loader->read_test(test);
 		//compute		
-		Scalar eval = (*m_test_function)((NeuralNetwork&)individual, test);
+		Scalar eval = execute_on_shards(*m_test_function, individual.m_network);
 		//return
 		return eval;
 	}
+	Scalar DennAlgorithm::execute_on_shards(Evaluation& function, const NeuralNetwork& network) const
+	{
+		//a shard for each thread (split once by the instance)
+		size_t n_shards = m_thpool && m_thpool->size() > 1 && function.reducible() ? m_thpool->size() : 1;
+		Instance::DataSetShards test_shards = m_instance.test_shards(n_shards);
+		const std::vector<DataSetScalar>& shards = *test_shards;
+		//serial
+		if (shards.size() == 1)
+		{
+			return function(network, shards[0]);
+		}
+		//n samples
+		size_t samples = 0;
+		for (const DataSetScalar& shard : shards) samples += shard.features().cols();
+		//partial results
+		std::vector<Scalar> partials(shards.size(), Scalar(0));
+		m_thpool->parallel_for(0, shards.size(), 1, [&](size_t start, size_t end)
+		{
+			//the same network, activations of the thread
+			thread_local NeuralNetwork::Workspace workspace;
+			//eval
+			for (size_t s = start; s != end; ++s)
+			{
+				if (function.use_logits(network))
+					partials[s] = function.logits_partial(network.predict(shards[s], workspace, true), shards[s]);
+				else
+					partials[s] = function.partial(network.predict(shards[s], workspace), shards[s]);
+			}
+		})->wait();
+		//reduction, in order
+		Scalar sum = Scalar(0);
+		for (Scalar partial : partials) sum += partial;
+		//return
+		return function.reduce(sum, samples);
+	}
 	/////////////////////////////////////////////////////////////////
 	//test
 	//find best individual (validation test)
@@ -165,8 +202,7 @@ namespace Denn
 		//ref to pop
 		auto& population = m_population.parents();
 		//validation
-		DataSetScalar validation;
-		m_dataset_loader->read_validation(validation);
+		const DataSetScalar& validation = m_instance.validation_set();
 		//best
 		Scalar best_eval =  validation_function_worst();
 		size_t	   best_i= 0;
@@ -175,7 +211,7 @@ namespace Denn
 		{
 			auto& i_target = *population[i];
 			//test
-			Scalar eval = (*m_validation_function)((NeuralNetwork&)i_target, validation);
+			Scalar eval = (*m_validation_function)(evaluation_network(i_target), validation);
 			//safe, nan = worst
 			if (std::isnan(eval)) eval = validation_function_worst();
 			//find best
@@ -198,29 +234,23 @@ namespace Denn
 		//get np
 		size_t np = current_np();
 		//validation
-		DataSetScalar validation;
-		m_dataset_loader->read_validation(validation);
+		const DataSetScalar& validation = m_instance.validation_set();
 		//list eval
 		std::vector<Scalar> validation_evals(population.size(), validation_function_worst());
-		//alloc promises
-		m_promises.resize(np);
 		//for all
-		for (size_t i = 0; i != np; ++i)
+		thpool.parallel_for(0, np, 0, [&](size_t start, size_t end)
 		{
-			//ref to target
-			auto& i_target = *population[i];
-			auto& eval     = validation_evals[i];
-			//add
-			m_promises[i] = thpool.push_task([&]()
+			for (size_t i = start; i != end; ++i)
 			{
+				//ref to target
+				auto& i_target = *population[i];
+				auto& eval     = validation_evals[i];
 				//test
-				eval = (*m_validation_function)((NeuralNetwork&)i_target, validation);
+				eval = (*m_validation_function)(evaluation_network(i_target), validation);
 				//safe, nan = worst
 				if (std::isnan(eval)) eval = validation_function_worst();;
-			});
-		}
-		//wait
-		for (auto& promise : m_promises) promise.wait();
+			}
+		})->wait();
 		//find best
 		if(m_validation_function->minimize())
 		{
@@ -319,8 +349,9 @@ namespace Denn
                 m_nnlast = m_best_ctx.m_best->m_network;
 				m_nnmask_bchanged = true;
             }
-			//it can change the values of the best individual
-			m_best_ctx.m_best = curr->copy();
+			//it can change the values of the best individual (a float copy, the parents can be packed)
+			if (!m_best_ctx.m_best) m_best_ctx.m_best = std::make_shared<Individual>();
+			m_best_ctx.m_best->unpack_from(*curr);
 			//save eval (on validation) of best
 			m_best_ctx.m_eval = curr_eval;
 		}
@@ -347,8 +378,9 @@ namespace Denn
                 m_nnlast = m_best_ctx.m_best->m_network;
 				m_nnmask_bchanged = true;
             }
-			//it can change the values of the best individual
-			m_best_ctx.m_best = curr->copy();
+			//it can change the values of the best individual (a float copy, the parents can be packed)
+			if (!m_best_ctx.m_best) m_best_ctx.m_best = std::make_shared<Individual>();
+			m_best_ctx.m_best->unpack_from(*curr);
 			//save eval (on test set) of best
 			m_best_ctx.m_eval = curr->m_eval;
 		}
@@ -481,18 +513,46 @@ namespace Denn
 			size_t np = current_np();
 			//get parents
 			auto& parents = m_population.parents();
-			//clear
-			last_parents.clear();
-			last_parents.reserve(np);
+			//same size
+			last_parents.resize(np);
 			//copy
-			for (size_t i = 0; i != np; ++i) last_parents.push_back(parents[i]->copy());
+			for (size_t i = 0; i != np; ++i)
+			{
+				if (last_parents[i]) last_parents[i]->copy_from(*parents[i]);
+				else 				 last_parents[i] = parents[i]->copy();
+			}
 		}
 
+		//pre-screening stats, before the pass
+		size_t last_screened = m_prescreening_ctx.m_screened;
+		size_t last_rejected = m_prescreening_ctx.m_rejected;
+
 		m_e_method->start_a_subgen_pass(m_population);
 		if (m_thpool) parallel_execute_pass(*m_thpool);
 		else          serial_execute_pass();
 		m_e_method->end_a_subgen_pass(m_population);
 
+		//pre-screening rate save
+		if(*m_params.m_prescreening && (*m_params.m_prescreening_output).size())
+		{
+			//of this generation
+			size_t screened = m_prescreening_ctx.m_screened - last_screened;
+			size_t rejected = m_prescreening_ctx.m_rejected - last_rejected;
+			Scalar rate = screened ? Scalar(rejected) / Scalar(screened) : Scalar(0);
+			//save
+			if(!Filesystem::exists(m_params.m_prescreening_output))
+			{
+				std::ofstream ofile(*m_params.m_prescreening_output, std::ios_base::app | std::ios_base::out);
+				ofile << "generation, screened, rejected, rate"  << std::endl;
+				ofile << gen << ", " << screened << ", " << rejected << ", " << rate << std::endl;
+			}
+			else
+			{
+				std::ofstream ofile(*m_params.m_prescreening_output, std::ios_base::app);
+				ofile << gen << ", " << screened << ", " << rejected << ", " << rate << std::endl;
+			}
+		}
+
 		//success rate compute and save
 		if(*m_params.m_save_success_rate)
 		{
@@ -555,13 +615,14 @@ namespace Denn
 			size_t np = current_np();
 			//get parents
 			auto& parents = m_population.parents();
-			//network
-			auto avg_nn(parents[0]->m_network);
+			//float networks (the parents can be packed)
+			NeuralNetwork avg_nn, parent_nn;
+			avg_nn.unpack_from(parents[0]->m_network);
 			//compute avg
 			for (size_t i = 1; i != np; ++i)
 			{
-				auto& parent = parents[i];
-				avg_nn += parent->m_network;
+				parent_nn.unpack_from(parents[i]->m_network);
+				avg_nn += parent_nn;
 			}
 			avg_nn.apply([np](Scalar w) -> Scalar {
 				return w / Scalar(np);
@@ -572,8 +633,8 @@ namespace Denn
 			//compute variance
 			for (size_t i = 0; i != np; ++i)
 			{
-				auto& parent = parents[i];
-				auto  diffnn = (parent->m_network - avg_nn);
+				parent_nn.unpack_from(parents[i]->m_network);
+				auto  diffnn = (parent_nn - avg_nn);
 				var_nn += diffnn * diffnn;
 			}
 			//compute avg
@@ -608,10 +669,28 @@ namespace Denn
 	{
 		//get np
 		size_t np = current_np();
+		//size of a group
+		size_t group = population_batch();
 		//for all
-		for (size_t i = 0; i != np; ++i)
+		if (!group)
+		{
+			for (size_t i = 0; i != np; ++i)
+			{
+				execute_generation_task(i);
+			}
+		}
+		else
 		{
-			execute_generation_task(i);
+			//new individuals
+			for (size_t i = 0; i != np; ++i)
+			{
+				execute_generation_create_task(i, *m_population.sons()[i]);
+			}
+			//eval, group by group
+			for (size_t start = 0; start < np; start += group)
+			{
+				execute_generation_group_task(start, std::min(start + group, np));
+			}
 		}
 		//swap
 		m_e_method->selection(m_population);
@@ -620,40 +699,104 @@ namespace Denn
 	{
 		//get np
 		size_t np = current_np();
-		//alloc promises
-		m_promises.resize(np);
+		//size of a group
+		size_t group = population_batch();
 		//execute
-		for (size_t i = 0; i != np; ++i)
+		thpool.parallel_for(0, np, 0, [this, group](size_t start, size_t end)
 		{
-			//add
-			m_promises[i] = thpool.push_task([this, i]()
+			for (size_t i = start; i != end; ++i)
 			{
-				execute_generation_task(i);
-			});
+				if (group) execute_generation_create_task(i, *m_population.sons()[i]);
+				else 	   execute_generation_task(i);
+			}
+		})->wait();
+		//eval, group by group
+		if (group)
+		{
+			thpool.parallel_for(0, np, group, [this](size_t start, size_t end)
+			{
+				execute_generation_group_task(start, end);
+			})->wait();
 		}
-		//wait
-		for (auto& promise : m_promises) promise.wait();
 		//swap
 		m_e_method->selection(m_population);
 	}
 	void DennAlgorithm::execute_generation_task(size_t i)
 	{
-		//ref to sons
-		auto& parents = m_population.parents();
-		auto& sons = m_population.sons();
-		//get temp individual
-		auto& parent = parents[i];
-		auto& son = sons[i];
+		//ref to son
+		auto& son = m_population.sons()[i];
+		//a packed son is computed and evaluated as a float network of the thread
+		thread_local Individual unpacked;
+		const GenomePrecision precision = m_population.m_genome_precision;
+		const bool packed = precision != GenomePrecision::GP_FLOAT;
+		if (packed)
+		{
+			if (!unpacked.m_network.same_layout(m_default->m_network)) unpacked.m_network.copy_from(m_default->m_network);
+			unpacked.copy_attributes(*son);
+			execute_generation_create_task(i, unpacked);
+			//stored with the precision of the population, evaluated as stored
+			son->copy_packed_from(unpacked, precision);
+			unpacked.m_network.unpack_from(son->m_network);
+		}
+		else
+		{
+			execute_generation_create_task(i, *son);
+		}
+		const NeuralNetwork& network = packed ? unpacked.m_network : son->m_network;
+		//eval, activations of the thread
+		thread_local NeuralNetwork::Workspace workspace;
+		//cheap path
+		if (m_prescreening_ctx.m_enabled && execute_generation_prescreening(i, network, workspace)) return;
+		bool logits = m_loss_function->use_logits(network);
+		son->m_eval = m_loss_function->evaluate(network.feedforward(current_batch(), workspace, &random(i), logits), current_batch(), logits);
+	}
+	bool DennAlgorithm::execute_generation_prescreening(size_t i, const NeuralNetwork& network, NeuralNetwork::Workspace& workspace)
+	{
+		//refs
+		auto& parent = m_population.parents()[i];
+		auto& son = m_population.sons()[i];
+		//eval with int8 products
+		bool logits = m_loss_function->use_logits(network);
+		Scalar eval = m_loss_function->evaluate(network.quantized_predict(current_batch(), workspace, logits), current_batch(), logits);
+		++m_prescreening_ctx.m_screened;
+		//worse than the parent by more than the margin? (nan = exact evaluation)
+		Scalar margin = *m_params.m_prescreening_margin * std::abs(parent->m_eval);
+		bool rejected = m_loss_function->minimize() ? eval > parent->m_eval + margin
+													: eval < parent->m_eval - margin;
+		if (!rejected) return false;
+		//the approximation is only a statistic, the worst eval makes every selection (crowding too) discard the son
+		son->m_eval = loss_function_worst();
+		++m_prescreening_ctx.m_rejected;
+		return true;
+	}
+	void DennAlgorithm::execute_generation_group_task(size_t start, size_t end)
+	{
+		//sons of the group
+		thread_local std::vector<size_t> group;
+		group.clear();
+		//eval, activations of the thread
+		thread_local NeuralNetwork::Workspace workspace;
+		for (size_t i = start; i != end; ++i)
+		{
+			//cheap path, a rejected son is not in the group pass
+			if (m_prescreening_ctx.m_enabled && execute_generation_prescreening(i, m_population.sons()[i]->m_network, workspace)) continue;
+			group.push_back(i);
+		}
+		//a single pass for all the sons left
+		execute_loss_function_on_a_group(m_population.sons(), group, true);
+	}
+	void DennAlgorithm::execute_generation_create_task(size_t i, Individual& son)
+	{
+		//ref to parent
+		auto& parent = m_population.parents()[i];
 		//Compute new individual
-		m_e_method->create_a_individual(m_population, i, *son);
+		m_e_method->create_a_individual(m_population, i, son);
 		//test
 		if(*m_params.m_use_mask)
 		{
 			//net
-			son->m_network.apply_mask(m_nnmask, parent->m_network);
+			son.m_network.apply_mask(m_nnmask, parent->m_network);
 		}
-		//eval
-		son->m_eval = (*m_loss_function)(son->m_network.feedforward(current_batch().features(), &random(i)),  current_batch());
 	}
 	
 	/////////////////////////////////////////////////////////////////
@@ -662,6 +805,17 @@ namespace Denn
 	{
 		execute_loss_function_on_all_population(population);
 	}
+	size_t DennAlgorithm::population_batch() const
+	{
+		return m_population.m_genome_precision == GenomePrecision::GP_FLOAT ? size_t(*m_params.m_population_batch) : size_t(0);
+	}
+	const NeuralNetwork& DennAlgorithm::evaluation_network(const Individual& individual) const
+	{
+		if (!individual.m_network.genome_packed()) return individual.m_network;
+		thread_local NeuralNetwork unpacked;
+		unpacked.unpack_from(individual.m_network);
+		return unpacked;
+	}
 	void DennAlgorithm::execute_loss_function_on_all_population(Population& population) const
 	{
 		//eval on batch
@@ -672,13 +826,24 @@ namespace Denn
 	{
 		//np
 		size_t np = current_np();
+		//size of a group
+		size_t group = population_batch();
+		//group by group
+		if (group)
+		{
+			for (size_t start = 0; start < np; start += group)
+			{
+				execute_loss_function_on_a_group(population, start, std::min(start + group, np), false);
+			}
+			return;
+		}
 		//for all
 		for (size_t i = 0; i != np; ++i)
 		{
 			//ref to loss
 			auto& i_target = *population[i];
 			//eval
-			i_target.m_eval = (*m_loss_function)((NeuralNetwork&)i_target, current_batch());
+			i_target.m_eval = (*m_loss_function)(evaluation_network(i_target), current_batch());
 			//safe, nan = worst
 			if (std::isnan(i_target.m_eval)) i_target.m_eval = loss_function_worst(); 
 		}
@@ -687,24 +852,68 @@ namespace Denn
 	{
 		//get np
 		size_t np = current_np();
-		//alloc promises
-		m_promises.resize(np);
+		//size of a group
+		size_t group = population_batch();
+		//group by group
+		if (group)
+		{
+			//for all groups
+			thpool.parallel_for(0, np, group, [this, &population](size_t start, size_t end)
+			{
+				execute_loss_function_on_a_group(population, start, end, false);
+			})->wait();
+			return;
+		}
 		//for all
-		for (size_t i = 0; i != np; ++i)
+		thpool.parallel_for(0, np, 0, [this, &population](size_t start, size_t end)
 		{
-			//ref to target
-			auto& i_target = *population[i];
-			//add
-			m_promises[i] = thpool.push_task([this,&i_target]()
+			for (size_t i = start; i != end; ++i)
 			{
+				//ref to target
+				auto& i_target = *population[i];
 				//test
-				i_target.m_eval = (*m_loss_function)((NeuralNetwork&)i_target, current_batch());
+				i_target.m_eval = (*m_loss_function)(evaluation_network(i_target), current_batch());
 				//safe, nan = worst
 				if (std::isnan(i_target.m_eval)) i_target.m_eval = loss_function_worst(); 
-			});
+			}
+		})->wait();
+	}
+	
+	void DennAlgorithm::execute_loss_function_on_a_group(Population& population, size_t start, size_t end, bool feedforward) const
+	{
+		//individuals of the group
+		thread_local std::vector<size_t> group;
+		group.clear();
+		for (size_t i = start; i != end; ++i) group.push_back(i);
+		execute_loss_function_on_a_group(population, group, feedforward);
+	}
+	void DennAlgorithm::execute_loss_function_on_a_group(Population& population, const std::vector<size_t>& group, bool feedforward) const
+	{
+		//networks of the group
+		thread_local std::vector<const NeuralNetwork*> networks;
+		thread_local std::vector<Random*> randoms;
+		networks.clear();
+		randoms.clear();
+		for (size_t i : group)
+		{
+			networks.push_back(&population[i]->m_network);
+			randoms.push_back(&random(i));
+		}
+		//the same topology for all the group
+		bool logits = !networks.empty() && m_loss_function->use_logits(*networks[0]);
+		//a single pass on the batch for all the group
+		if (feedforward) NeuralNetwork::feedforward(networks, current_batch(), randoms, logits);
+		else 			 NeuralNetwork::predict(networks, current_batch(), logits);
+		//eval
+		for (size_t i : group)
+		{
+			//ref to target
+			auto& i_target = *population[i];
+			//test
+			i_target.m_eval = m_loss_function->evaluate(i_target.m_network.output(logits), current_batch(), logits);
+			//safe, nan = worst
+			if (!feedforward && std::isnan(i_target.m_eval)) i_target.m_eval = loss_function_worst(); 
 		}
-		//wait
-		for (auto& promise : m_promises) promise.wait();
 	}
 	
 	/////////////////////////////////////////////////////////////////
@@ -0,0 +1,86 @@
+#include "Denn/Config.h"
+#include "Denn/Core/IOFileWrapper.h"
+#ifdef _WIN32
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/types.h>
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace Denn
+{
+namespace IOFileWrapper
+{
+	bool mmap_file::open(const std::string& pathfile, const std::string& mode)
+	{
+		//only read mode
+		if (mode.empty() || mode[0] != 'r') return false;
+		//close last
+		close();
+	#ifdef _WIN32
+		HANDLE file = CreateFileA(pathfile.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+		if (file == INVALID_HANDLE_VALUE) return false;
+		//size
+		LARGE_INTEGER file_size;
+		if (!GetFileSizeEx(file, &file_size) || !file_size.QuadPart)
+		{
+			CloseHandle(file);
+			return false;
+		}
+		//map
+		HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+		CloseHandle(file);
+		if (!mapping) return false;
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data)
+		{
+			CloseHandle(mapping);
+			return false;
+		}
+		m_handle = (void*)mapping;
+		m_size = (size_t)file_size.QuadPart;
+	#else
+		int file = ::open(pathfile.c_str(), O_RDONLY);
+		if (file < 0) return false;
+		//size
+		struct stat file_stat;
+		if (::fstat(file, &file_stat) != 0 || !file_stat.st_size)
+		{
+			::close(file);
+			return false;
+		}
+		//map
+		void* data = ::mmap(nullptr, (size_t)file_stat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+		::close(file);
+		if (data == MAP_FAILED) return false;
+		//sequential read
+		::madvise(data, (size_t)file_stat.st_size, MADV_SEQUENTIAL);
+		m_size = (size_t)file_stat.st_size;
+	#endif
+		m_data = (const unsigned char*)data;
+		m_pos = 0;
+		return true;
+	}
+
+	void mmap_file::close()
+	{
+		if (m_data)
+		{
+		#ifdef _WIN32
+			UnmapViewOfFile((LPCVOID)m_data);
+			CloseHandle((HANDLE)m_handle);
+		#else
+			::munmap((void*)m_data, m_size);
+		#endif
+		}
+		m_data = nullptr;
+		m_size = 0;
+		m_pos = 0;
+		m_handle = nullptr;
+	}
+}
+}
@@ -3,15 +3,105 @@
 
 namespace Denn
 {
-	Random::Random(unsigned int seed) 
-	: m_generator (seed)
-	, m_deck(*this)
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+	//philox constants
+	static constexpr uint32_t philox_m0 = 0xD2511F53;
+	static constexpr uint32_t philox_m1 = 0xCD9E8D57;
+	static constexpr uint32_t philox_w0 = 0x9E3779B9;
+	static constexpr uint32_t philox_w1 = 0xBB67AE85;
+
+	void Philox4x32::seed(uint64_t value)
+	{
+		m_key[0] = uint32_t(value);
+		m_key[1] = uint32_t(value >> 32);
+		m_counter[0] = m_counter[1] = m_counter[2] = m_counter[3] = 0;
+		m_i = 4;
+	}
+
+	void Philox4x32::block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4])
+	{
+		uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+		uint32_t k0 = key[0], k1 = key[1];
+		//10 rounds
+		for (int r = 0; r != 10; ++r)
+		{
+			const uint64_t p0 = uint64_t(philox_m0) * c0;
+			const uint64_t p1 = uint64_t(philox_m1) * c2;
+			c0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+			c1 = uint32_t(p1);
+			c2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+			c3 = uint32_t(p0);
+			//bump key
+			k0 += philox_w0;
+			k1 += philox_w1;
+		}
+		out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+	}
+
+	void Philox4x32::next_block()
+	{
+		block(m_counter, m_key, m_block);
+		//128 bit counter
+		for (int i = 0; i != 4 && !++m_counter[i]; ++i);
+		m_i = 0;
+	}
+
+	void Philox4x32::generate(result_type* out, size_t n)
+	{
+		//values left in the block
+		while (n && m_i != 4) { *(out++) = m_block[m_i++]; --n; }
+		//whole blocks, the rounds of a block are independent of the others
+		for (; n >= 4; n -= 4, out += 4)
+		{
+			block(m_counter, m_key, out);
+			for (int i = 0; i != 4 && !++m_counter[i]; ++i);
+		}
+		//tail
+		while (n) { *(out++) = (*this)(); --n; }
+	}
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+	//M_PI is not standard
+	static constexpr Scalar pi = Scalar(3.14159265358979323846);
+	//[0,1) from 24 bits
+	static inline Scalar philox_unit(uint32_t x)
+	{
+		return Scalar(x >> 8) * Scalar(1.0 / 16777216.0);
+	}
+	//box-muller, a value from two
+	static inline Scalar philox_normal(uint32_t x, uint32_t y, Scalar mean, Scalar stddev)
+	{
+		const Scalar u1 = Scalar(1.0) - philox_unit(x); //(0,1]
+		const Scalar u2 = philox_unit(y);
+		return mean + stddev * std::sqrt(Scalar(-2.0) * std::log(u1)) * std::cos(Scalar(2.0) * pi * u2);
+	}
+	//inverse cdf
+	static inline Scalar philox_cauchy(uint32_t x, Scalar location, Scalar scale)
+	{
+		return location + scale * std::tan(pi * (philox_unit(x) - Scalar(0.5)));
+	}
+	//bits per chunk of a bulk fill
+	static constexpr size_t philox_chunk = 256;
+
+	////////////////////////////////////////////////////////////////////////////////////////////////////////
+	bool Random::generator_by_name(const std::string& name, Generator& generator)
+	{
+		if (name == "mt19937") { generator = RG_MT19937; return true; }
+		if (name == "philox")  { generator = RG_PHILOX;  return true; }
+		return false;
+	}
+
+	Random::Random(unsigned int seed, Generator generator)
+	: m_deck(*this)
 	, m_deck_ring_segment(*this) 
 	{
+		reinit(seed, generator);
 	}
 
 	Random::Random(const Random& random) 
-	: m_generator        (random.m_generator)
+	: m_generator_type   (random.m_generator_type)
+	, m_generator        (random.m_generator ? std::make_unique<std::mt19937>(*random.m_generator) : nullptr)
+	, m_philox           (random.m_philox)
 	, m_deck             (*this,random.deck())
 	, m_deck_ring_segment(*this,random.deck_ring_segment()) 
 	{
@@ -20,65 +110,123 @@ namespace Denn
 	//reinit
 	void Random::reinit(unsigned int seed)
 	{
-		m_generator = std::mt19937(seed);
+		reinit(seed, m_generator_type);
+	}
+	void Random::reinit(unsigned int seed, Generator generator)
+	{
+		m_generator_type = generator;
+		switch (m_generator_type)
+		{
+		case RG_PHILOX:
+			m_generator = nullptr;
+			m_philox.seed(seed);
+		break;
+		default:
+			m_generator = std::make_unique<std::mt19937>(seed);
+		break;
+		}
 	}
 
 	//random integer in [0,size)
 	int Random::irand(int max)
 	{
 		std::uniform_int_distribution<int> distribution(0, max-1);
-		return distribution(m_generator);
+		return m_generator ? distribution(*m_generator) : distribution(m_philox);
 	}
 	int Random::irand(int min, int max)
 	{
 		std::uniform_int_distribution<int> distribution(min, max-1);
-		return distribution(m_generator);
+		return m_generator ? distribution(*m_generator) : distribution(m_philox);
 	}
 
 	//random unsigned integer in [0,size)
 	unsigned int Random::uirand(unsigned int max)
 	{
 		std::uniform_int_distribution<unsigned int> distribution(0, max-1);
-		return distribution(m_generator);
+		return m_generator ? distribution(*m_generator) : distribution(m_philox);
 	}
 	unsigned int Random::uirand(unsigned int min,unsigned int max)
 	{
 		std::uniform_int_distribution<unsigned int> distribution(min, max-1);
-		return distribution(m_generator);
+		return m_generator ? distribution(*m_generator) : distribution(m_philox);
 	}
 
 	//random integer in [0,size)
 	size_t Random::index_rand(size_t max)
 	{
 		std::uniform_int_distribution<size_t> distribution(0, max-1);
-		return distribution(m_generator);
+		return m_generator ? distribution(*m_generator) : distribution(m_philox);
 	}
 
 	//random value in flooting point [min,max]
 	Scalar Random::uniform(Scalar min, Scalar max)
-#if defined( USE_FAST_UNIFORM ) //vc performance issues
 	{
+		if (!m_generator) return min + philox_unit(m_philox()) * (max - min);
+#if defined( USE_FAST_UNIFORM ) //vc performance issues
 		std::uniform_int_distribution<unsigned int> distribution(0, std::numeric_limits<unsigned int>::max());
-		return Scalar(distribution(m_generator)) * (Scalar(1.0) / std::numeric_limits<unsigned int>::max()) * (max-min) + min;
-	}
+		return Scalar(distribution(*m_generator)) * (Scalar(1.0) / std::numeric_limits<unsigned int>::max()) * (max-min) + min;
 #else
-	{
 		std::uniform_real_distribution<Scalar> distribution(min, max);
-		return distribution(m_generator);
-	}
+		return distribution(*m_generator);
 #endif
+	}
 	//random value generated by normal distribution given a mean and a standard deviation in flooting point
 	Scalar Random::normal(Scalar m, Scalar s)
 	{
+		if (!m_generator)
+		{
+			const uint32_t x = m_philox();
+			const uint32_t y = m_philox();
+			return philox_normal(x, y, m, s);
+		}
 		std::normal_distribution<Scalar> distribution(m, s);
-		return distribution(m_generator);
+		return distribution(*m_generator);
 	}
 
 	//random value generated by cauchy distribution given a location and a scale in flooting point
 	Scalar Random::cauchy(Scalar location, Scalar scale)
 	{
+		if (!m_generator) return philox_cauchy(m_philox(), location, scale);
 		std::cauchy_distribution<Scalar> distribution(location, scale);
-		return distribution(m_generator);
+		return distribution(*m_generator);
+	}
+
+	//bulk fills, mt19937 draws a value at time (same sequence), philox a chunk of bits at time
+	void Random::uniform_fill(Scalar* out, size_t n, Scalar min, Scalar max)
+	{
+		if (m_generator) { for (size_t i = 0; i != n; ++i) out[i] = uniform(min, max); return; }
+		uint32_t bits[philox_chunk];
+		const Scalar range = max - min;
+		for (size_t start = 0; start < n; start += philox_chunk)
+		{
+			const size_t count = std::min(philox_chunk, n - start);
+			m_philox.generate(bits, count);
+			for (size_t i = 0; i != count; ++i) out[start + i] = min + philox_unit(bits[i]) * range;
+		}
+	}
+
+	void Random::normal_fill(Scalar* out, size_t n, Scalar mean, Scalar stddev)
+	{
+		if (m_generator) { for (size_t i = 0; i != n; ++i) out[i] = normal(mean, stddev); return; }
+		uint32_t bits[philox_chunk];
+		for (size_t start = 0; start < n; start += philox_chunk / 2)
+		{
+			const size_t count = std::min(philox_chunk / 2, n - start);
+			m_philox.generate(bits, count * 2);
+			for (size_t i = 0; i != count; ++i) out[start + i] = philox_normal(bits[2 * i], bits[2 * i + 1], mean, stddev);
+		}
+	}
+
+	void Random::cauchy_fill(Scalar* out, size_t n, Scalar location, Scalar scale)
+	{
+		if (m_generator) { for (size_t i = 0; i != n; ++i) out[i] = cauchy(location, scale); return; }
+		uint32_t bits[philox_chunk];
+		for (size_t start = 0; start < n; start += philox_chunk)
+		{
+			const size_t count = std::min(philox_chunk, n - start);
+			m_philox.generate(bits, count);
+			for (size_t i = 0; i != count; ++i) out[start + i] = philox_cauchy(bits[i], location, scale);
+		}
 	}
 
 	////////////////////////////////////////////////////////////////////////////////////////////////////////
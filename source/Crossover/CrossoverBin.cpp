@@ -1,5 +1,6 @@
 #include "Denn/Crossover.h"
 #include "Denn/Parameters.h"
+#include "Denn/Algorithm.h"
 
 namespace Denn
 {
@@ -20,16 +21,18 @@ namespace Denn
 				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
 				{
 					//elements
-					auto w_target = i_target[i_layer][m].array();
+					auto w_target = target_matrix(i_target, i_layer, m).array();
 					auto w_mutant = i_mutant[i_layer][m].array();
 					//random i
 					size_t e_rand = random(id_target).index_rand(w_target.size());
+					//a uniform for each element but e_rand
+					const Scalar* uniforms = draw_uniforms(id_target, w_target.size() - 1);
 					//CROSS
 					for (decltype(w_target.size()) e = 0; e != w_target.size(); ++e)
 					{
 						//crossover
 						//!(RandomIndices::random() < cr || e_rand == e)
-						if (e_rand != e && cr <= random(id_target).uniform())
+						if (e_rand != e && cr <= uniforms[e - (e > e_rand)])
 						{
 							w_mutant(e) = w_target(e);
 						}
@@ -37,6 +40,40 @@ namespace Denn
 				}
 			}
 		}
+
+		virtual bool fused(const Population& population, size_t id_target, const MutationKernels& kernels, Individual& i_mutant) override
+		{
+			//baias
+			const auto& i_target = *population[id_target];
+			const auto& cr = i_mutant.m_cr;
+			const auto& clamp = m_algorithm.clamp_function();
+			size_t k = 0;
+			//for each layers
+			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
+			{
+				//weights and baias
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
+				{
+					//elements
+					auto w_target = target_matrix(i_target, i_layer, m).array();
+					auto w_mutant = i_mutant[i_layer][m].array();
+					const MutationKernel& kernel = kernels[k];
+					//random i
+					size_t e_rand = random(id_target).index_rand(w_target.size());
+					//a uniform for each element but e_rand
+					const Scalar* uniforms = draw_uniforms(id_target, w_target.size() - 1);
+					//CROSS, the mutant only where it is kept
+					for (decltype(w_target.size()) e = 0; e != w_target.size(); ++e)
+					{
+						if (e_rand != e && cr <= uniforms[e - (e > e_rand)])
+							w_mutant(e) = w_target(e);
+						else
+							w_mutant(e) = clamp(kernel(e));
+					}
+				}
+			}
+			return true;
+		}
     };
 	REGISTERED_CROSSOVER(Bin,"bin")
 }
\ No newline at end of file
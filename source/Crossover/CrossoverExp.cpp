@@ -1,5 +1,6 @@
 #include "Denn/Crossover.h"
 #include "Denn/Parameters.h"
+#include "Denn/Algorithm.h"
 
 namespace Denn
 {
@@ -20,11 +21,13 @@ namespace Denn
 				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
 				{
 					//elements
-					auto w_target = i_target[i_layer][m].array();
+					auto w_target = target_matrix(i_target, i_layer, m).array();
 					auto w_mutant = i_mutant[i_layer][m].array();
 					//random i
 					size_t e_rand = random(id_target).index_rand(w_target.size());
 					size_t e_start = random(id_target).index_rand(w_target.size());
+					//a uniform for each element but e_rand, in visit order
+					const Scalar* uniforms = draw_uniforms(id_target, w_target.size() - 1);
 					//event
 					bool copy_event = false;
 					//CROSS
@@ -34,7 +37,7 @@ namespace Denn
 						size_t e_circ = (e_start + e) % w_target.size();
 						//crossover
 						//!(RandomIndices::random() < cr || e_rand == e)
-						copy_event |= (e_rand != e_circ && cr <= random(id_target).uniform());
+						copy_event |= (e_rand != e_circ && cr <= *(uniforms++));
 						//copy all vector
 						if (copy_event)
 						{
@@ -44,6 +47,48 @@ namespace Denn
 				}
 			}
 		}
+
+		virtual bool fused(const Population& population, size_t id_target, const MutationKernels& kernels, Individual& i_mutant) override
+		{
+			//baias
+			const auto& i_target = *population[id_target];
+			const auto& cr = i_mutant.m_cr;
+			const auto& clamp = m_algorithm.clamp_function();
+			size_t k = 0;
+			//for each layers
+			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
+			{
+				//weights and baias
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
+				{
+					//elements
+					auto w_target = target_matrix(i_target, i_layer, m).array();
+					auto w_mutant = i_mutant[i_layer][m].array();
+					const MutationKernel& kernel = kernels[k];
+					//random i
+					size_t e_rand = random(id_target).index_rand(w_target.size());
+					size_t e_start = random(id_target).index_rand(w_target.size());
+					//a uniform for each element but e_rand, in visit order
+					const Scalar* uniforms = draw_uniforms(id_target, w_target.size() - 1);
+					//event
+					bool copy_event = false;
+					//CROSS, the mutant only before the event
+					for (decltype(w_target.size()) e = 0; e != w_target.size(); ++e)
+					{
+						//id circ
+						size_t e_circ = (e_start + e) % w_target.size();
+						//crossover
+						copy_event |= (e_rand != e_circ && cr <= *(uniforms++));
+						//copy all vector
+						if (copy_event)
+							w_mutant(e_circ) = w_target(e_circ);
+						else
+							w_mutant(e_circ) = clamp(kernel(e_circ));
+					}
+				}
+			}
+			return true;
+		}
 	};
 	REGISTERED_CROSSOVER(Exp, "exp")
 }
\ No newline at end of file
@@ -20,12 +20,14 @@ namespace Denn
 				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
 				{
 					//elements
-					auto w_target = i_target[i_layer][m].array();
+					auto w_target = target_matrix(i_target, i_layer, m).array();
 					auto w_mutant = i_mutant[i_layer][m].array();
+					//a factor for each element
+					const Scalar* factors = draw_uniforms(id_target, w_target.size());
 					//CROSS
 					for (decltype(w_target.size()) e = 0; e != w_target.size(); ++e)
 					{
-						Scalar factor = random(id_target).uniform();
+						Scalar factor = factors[e];
 						w_mutant(e) = w_target(e) + factor * (w_mutant(e) - w_target(e));
 					}
 				}
@@ -51,7 +53,7 @@ namespace Denn
 				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
 				{
 					//elements
-					auto w_target = i_target[i_layer][m].array();
+					auto w_target = target_matrix(i_target, i_layer, m).array();
 					auto w_mutant = i_mutant[i_layer][m].array();
 					//random i
 					size_t e_rand = random(id_target).index_rand(w_target.size());
@@ -20,6 +20,20 @@ namespace Denn
 
 	Random& Crossover::population_random(size_t i)       const { return m_algorithm.population_random(i);}
 	Random& Crossover::random(size_t i)			         const { return m_algorithm.random(i); }
+
+	const Scalar* Crossover::draw_uniforms(size_t i, size_t n) const
+	{
+		thread_local std::vector< Scalar > uniforms;
+		if (uniforms.size() < n) uniforms.resize(n);
+		random(i).uniform_fill(uniforms.data(), n);
+		return uniforms.data();
+	}
+
+	ConstAlignedMapMatrix Crossover::target_matrix(const Individual& target, size_t i_layer, size_t m) const
+	{
+		thread_local Matrix buffer;
+		return target.m_network.genome_matrix(i_layer, m, buffer);
+	}
 	
 	//help, how is the best
 	bool Crossover::loss_function_compare(Scalar left, Scalar right) const       { return  m_algorithm.loss_function_compare(left,right);  }
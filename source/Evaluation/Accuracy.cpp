@@ -10,20 +10,22 @@ namespace Denn
         virtual bool minimize() const { return false; }
         virtual Scalar operator () (const Matrix& x, const DataSet& dataset)
         {
-            const Matrix& y = dataset.labels();
-            //output
-            Scalar output = Scalar(0.0);
-            //values
-            Matrix::Index  max_index_x, max_index_y;
-            //max-max
-            for (Matrix::Index j = 0; j < x.cols(); ++j)
-            {
-                x.col(j).maxCoeff(&max_index_x);
-                y.col(j).maxCoeff(&max_index_y);
-                output += Scalar(max_index_x == max_index_y);
-            }
-            //
-            return output / Scalar(x.cols());
+            return reduce(partial(x, dataset), x.cols());
+        }
+        //number of hits
+        virtual bool reducible() const { return true; }
+        virtual Scalar partial(const Matrix& x, const DataSet& dataset)
+        {
+            const ClassIndices& y = classes(dataset);
+            //max of each column
+            thread_local ClassIndices x_classes;
+            internal::colwise_argmax(x, x_classes);
+            //hits
+            return Scalar((x_classes == y).count());
+        }
+        virtual Scalar reduce(Scalar output, size_t samples) const
+        {
+            return output / Scalar(samples);
         }
 		
     };
@@ -36,20 +38,19 @@ namespace Denn
         virtual bool minimize() const { return false; }
         virtual Scalar operator () (const Matrix& x, const DataSet& dataset)
         {
-            const Matrix& y = dataset.labels();
-            //output
-            Scalar output = Scalar(0.0);
-            //values
-            Matrix::Index  val_x, val_y;
-            //max-max
-            for (Matrix::Index j = 0; j < x.cols(); ++j)
-            {
-                val_x =  x.col(j)(0) >= Scalar(0.5);
-                val_y =  y.col(j)(0) >= 0.5;
-                output += Scalar(val_x == val_y);
-            }
-            //
-            return output / Scalar(x.cols());
+            return reduce(partial(x, dataset), x.cols());
+        }
+        //number of hits
+        virtual bool reducible() const { return true; }
+        virtual Scalar partial(const Matrix& x, const DataSet& dataset)
+        {
+            const ClassIndices& y = classes(dataset);
+            //hits
+            return Scalar(((x.row(0).array() >= Scalar(0.5)).cast<int>() == y).count());
+        }
+        virtual Scalar reduce(Scalar output, size_t samples) const
+        {
+            return output / Scalar(samples);
         }
 		
     };
@@ -62,20 +63,22 @@ namespace Denn
         virtual bool minimize() const { return true; }
         virtual Scalar operator () (const Matrix& x, const DataSet& dataset)
         {			
-            const Matrix& y = dataset.labels();
-            //output
-            Scalar output = Scalar(0.0);
-            //values
-            Matrix::Index  max_index_x, max_index_y;
-            //max-max
-            for (Matrix::Index j = 0; j < x.cols(); ++j)
-            {
-                x.col(j).maxCoeff(&max_index_x);
-                y.col(j).maxCoeff(&max_index_y);
-                output += Scalar(max_index_x == max_index_y);
-            }
-            //
-            return -output / Scalar(x.cols());
+            return reduce(partial(x, dataset), x.cols());
+        }
+        //number of hits
+        virtual bool reducible() const { return true; }
+        virtual Scalar partial(const Matrix& x, const DataSet& dataset)
+        {
+            const ClassIndices& y = classes(dataset);
+            //max of each column
+            thread_local ClassIndices x_classes;
+            internal::colwise_argmax(x, x_classes);
+            //hits
+            return Scalar((x_classes == y).count());
+        }
+        virtual Scalar reduce(Scalar output, size_t samples) const
+        {
+            return -output / Scalar(samples);
         }
 		
     };
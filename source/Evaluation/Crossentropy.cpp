@@ -1,6 +1,8 @@
 #include "Denn/Core/Dump.h"
 #include "Denn/Evaluation.h"
 #include "Denn/Parameters.h"
+#include "Denn/Utilities/Transcendental.h"
+#include "Denn/Utilities/SoftmaxCrossEntropy.h"
 #include <iostream>
 
 namespace Denn
@@ -13,14 +15,40 @@ namespace Denn
         virtual Scalar operator () (const Matrix& pred, const DataSet& dataset)
         {
 			const int n = dataset.features().cols();
+			Scalar loss = reduce(partial(pred, dataset), n);
+			return loss;
+        }
+		//sum of the losses
+        virtual bool reducible() const { return true; }
+        virtual Scalar partial(const Matrix& pred, const DataSet& dataset)
+        {
 			const Scalar eps = SCALAR_EPS;
 			const Matrix& target = dataset.labels();
-			Scalar loss = -(target.array().cwiseProduct((pred.array() + eps).log())).sum() / Scalar(n);
-			return loss;
+			//log(y + eps)
+			thread_local Matrix log_pred;
+			log_pred = (pred.array() + eps).matrix();
+			Transcendental::log(log_pred);
+			return -(target.array().cwiseProduct(log_pred.array())).sum();
+        }
+        virtual Scalar reduce(Scalar loss, size_t samples) const
+        {
+			return loss / Scalar(samples);
         }
     };
     REGISTERED_EVALUATION(CrossEntropy,"cross_entropy")
 
+	class SoftmaxCrossEntropy : public CrossEntropy
+	{
+	public:
+		//the loss of the logits, log-sum-exp without the probabilities, the labels are one-hot (as cross_entropy if the last layer is not a softmax)
+        virtual bool from_logits() const { return true; }
+        virtual Scalar logits_partial(const Matrix& logits, const DataSet& dataset)
+        {
+			return internal::softmax_cross_entropy(logits, classes(dataset));
+        }
+    };
+    REGISTERED_EVALUATION(SoftmaxCrossEntropy,"softmax_cross_entropy")
+
 	class BinaryCrossEntropy : public DefaultEvaluation
 	{
 	public:
@@ -35,7 +63,14 @@ namespace Denn
 				const Scalar eps = SCALAR_EPS;
 				return clamp<Scalar>(y,eps,1 - eps); 
 			});
-			return  -(target.array() * pred_clamp.log() + (1 - target.array()) * (1 - pred_clamp).log()).sum() / Scalar(n);
+			//log(y), log(1 - y)
+			thread_local Matrix log_pred;
+			thread_local Matrix log_one_minus_pred;
+			log_pred = pred_clamp.matrix();
+			log_one_minus_pred = (1 - pred_clamp).matrix();
+			Transcendental::log(log_pred);
+			Transcendental::log(log_one_minus_pred);
+			return  -(target.array() * log_pred.array() + (1 - target.array()) * log_one_minus_pred.array()).sum() / Scalar(n);
         }
 		#elif 0
         {
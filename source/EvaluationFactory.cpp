@@ -9,14 +9,23 @@ namespace Denn
 {
 	//Evaluation
 	Evaluation::Evaluation(){}
+	const ClassIndices& Evaluation::classes(const DataSet& dataset)
+	{
+		if (dataset.classes().size() == dataset.labels().cols()) return dataset.classes();
+		thread_local ClassIndices classes;
+		internal::class_indices(dataset.labels(), classes);
+		return classes;
+	}
 	//default
 	DefaultEvaluation::DefaultEvaluation(){}
 	Scalar DefaultEvaluation::operator() (const NeuralNetwork& nn, const DataSet& db)
 	{
-		//prediction
-		const Matrix& pred = nn.predict(db.features());
+		//prediction, the network is not changed
+		thread_local NeuralNetwork::Workspace workspace;
+		bool logits = use_logits(nn);
+		const Matrix& pred = nn.predict(db, workspace, logits);
 		//self call
-		return get_ptr()->operator()(pred, db);
+		return get_ptr()->evaluate(pred, db, logits);
 	}	
 	//map 
 	static std::map< std::string, Evaluation::SPtr >& ev_map()
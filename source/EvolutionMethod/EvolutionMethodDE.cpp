@@ -39,10 +39,8 @@ namespace Denn
 			//copy
 			i_output.m_f  = target.m_f;
 			i_output.m_cr = target.m_cr;
-			//call muation
-			(*m_mutation) (parents, i_target, i_output);
-			//call crossover
-			(*m_crossover)(parents, i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutation, *m_crossover, parents, i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -38,7 +38,7 @@ namespace Denn
 				{
 					if( population_tmp[i]->m_eval < g_population.parents()[i]->m_eval )
 					{
-						g_population.parents()[i] = population_tmp[i]->copy();
+						g_population.parents()[i]->copy_from(*population_tmp[i]);
 					}
 				}
 			}
@@ -50,7 +50,7 @@ namespace Denn
 			}  
 			else
 			{
-				m_history[m_k] = g_population.parents().copy(); 
+				m_history[m_k].copy_from(g_population.parents());
 				m_k = (m_k + 1) % m_max_size;
 			} 
 			///////////////////////////////////////////////////////////////////////////////
@@ -98,7 +98,7 @@ namespace Denn
 				{
 					if( individual_tmp->m_eval < g_population.parents()[u]->m_eval )
 					{
-						g_population.parents()[u] = individual_tmp->copy();
+						g_population.parents()[u]->copy_from(*individual_tmp);
 						break;
 					}
 				}
@@ -111,7 +111,7 @@ namespace Denn
 			}  
 			else
 			{
-				m_history[m_k] = g_population.parents().copy(); 
+				m_history[m_k].copy_from(g_population.parents());
 				m_k = (m_k + 1) % m_max_size;
 			} 
 			///////////////////////////////////////////////////////////////////////////////
@@ -14,6 +14,7 @@ namespace Denn
 		JADEMethod(const DennAlgorithm& algorithm) : EvolutionMethod(algorithm) 
 		{
 			m_archive_max_size = parameters().m_archive_size;
+			genome_precision_from_string(parameters().m_archive_precision, m_archive_precision);
 			m_c_adapt          = parameters().m_f_cr_adapt;
 			m_mu_f       = Scalar(0.5);
 			m_mu_cr      = Scalar(0.5);
@@ -25,6 +26,7 @@ namespace Denn
 			m_mu_f = Scalar(0.5);
 			m_mu_cr = Scalar(0.5);
 			//clear
+			m_archive_pool.release(m_archive);
 			m_archive.clear();
 			//create mutation/crossover
 			m_mutation = MutationFactory::create(parameters().m_mutation_type, m_algorithm);
@@ -58,10 +60,8 @@ namespace Denn
 			i_output.m_f = Denn::sature(v);
 			//Cr
 			i_output.m_cr = Denn::sature(random(i_target).normal(m_mu_cr, 0.1));
-			//call muation
-			(*m_mutation) (dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutation, *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -88,7 +88,10 @@ namespace Denn
 				Individual::SPtr father = dpopulation.parents()[i];
 				Individual::SPtr son = dpopulation.sons()[m_swap_list[i]];
 				//compare?
-				if (m_archive_max_size) m_archive.push_back(father->copy());
+				if (m_archive_max_size)
+				{
+					m_archive.push_back(m_archive_pool.copy(*father, m_archive_precision));
+				}
 				//else if (main_random().uniform() < Scalar(m_archive_max_size) / Scalar(m_archive_max_size + n_discarded))
 				sum_f += son->m_f;
 				sum_f2 += son->m_f * son->m_f;
@@ -104,7 +107,9 @@ namespace Denn
 			//reduce A
 			while (m_archive_max_size < m_archive.size())
 			{
-				m_archive[main_random().index_rand(m_archive.size())] = m_archive.last();
+				size_t i_remove = main_random().index_rand(m_archive.size());
+				m_archive_pool.release(m_archive[i_remove]);
+				m_archive[i_remove] = m_archive.last();
 				m_archive.pop_back();
 			}
 			/////////////////////////////////////////////////////////////
@@ -124,6 +129,8 @@ namespace Denn
 		Scalar          m_mu_f      { Scalar(0.5) };
 		Scalar          m_mu_cr     { Scalar(0.5) };
 		Population	    m_archive;
+		IndividualPool	m_archive_pool;
+		GenomePrecision m_archive_precision{ GenomePrecision::GP_FLOAT };
 		Mutation::SPtr  m_mutation;
 		Crossover::SPtr m_crossover;
 		std::vector<int> m_swap_list;
@@ -47,10 +47,8 @@ namespace Denn
 				i_output.m_cr = Scalar(random(i_target).uniform());
 			else
 				i_output.m_cr = target.m_cr;
-			//call muation
-			(*m_mutation) (parents, i_target, i_output);
-			//call crossover
-			(*m_crossover)(parents, i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutation, *m_crossover, parents, i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -79,6 +79,7 @@ namespace Denn
 		{
 			//init
 			m_archive_max_size = parameters().m_archive_size;
+			genome_precision_from_string(parameters().m_archive_precision, m_archive_precision);
 			m_h = parameters().m_shade_h;
 		}
 
@@ -90,6 +91,7 @@ namespace Denn
 			m_k = 0;
 			m_pmin = Scalar(2) / Scalar(current_np());
 			//clear
+			m_archive_pool.release(m_archive);
 			m_archive.clear();
 			//clear
 			m_mutations_list.clear();
@@ -132,10 +134,8 @@ namespace Denn
 			i_output.m_cr = Denn::sature(random(i_target).normal(m_mu_cr[tou_i], 0.1));
 			//P
 			i_output.m_p = random(i_target).uniform(m_pmin, 0.2);
-			//call muation
-			(*m_mutations.get()) (dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutations.get(), *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -170,8 +170,10 @@ namespace Denn
 				Individual::SPtr father = dpopulation.parents()[i];
 				Individual::SPtr son = dpopulation.sons()[m_swap_list[i]];
 				//copy
-				if (m_archive_max_size) 
-					m_archive.push_back(father->copy());
+				if (m_archive_max_size)
+				{
+					m_archive.push_back(m_archive_pool.copy(*father, m_archive_precision));
+				}
 				//max
 				m_last_rewards += std::abs(std::abs(son->m_eval) - std::abs(father->m_eval)); // / std::abs(father->m_eval);
 				//F
@@ -201,7 +203,9 @@ namespace Denn
 			//reduce A
 			while (m_archive_max_size < m_archive.size())
 			{
-				m_archive[main_random().index_rand(m_archive.size())] = m_archive.last();
+				size_t i_remove = main_random().index_rand(m_archive.size());
+				m_archive_pool.release(m_archive[i_remove]);
+				m_archive[i_remove] = m_archive.last();
 				m_archive.pop_back();
 			}
 			/////////////////////////////////////////////////////////////
@@ -231,6 +235,8 @@ namespace Denn
 		std::vector<Scalar> m_mu_f;
 		std::vector<Scalar> m_mu_cr;
 		Population	        m_archive;
+		IndividualPool	    m_archive_pool;
+		GenomePrecision     m_archive_precision{ GenomePrecision::GP_FLOAT };
 		std::vector<Mutation::SPtr>      m_mutations_list;
 		MultiArmedBanditsBAIO<Mutation>  m_mutations;
 		Crossover::SPtr                  m_crossover;
@@ -245,6 +251,7 @@ namespace Denn
 		UCB1SHADEMethod(const DennAlgorithm &algorithm) : EvolutionMethod(algorithm)
 		{
 			m_archive_max_size = parameters().m_archive_size;
+			genome_precision_from_string(parameters().m_archive_precision, m_archive_precision);
 			m_h = parameters().m_shade_h;
 		}
 
@@ -256,6 +263,7 @@ namespace Denn
 			m_k = 0;
 			m_pmin = Scalar(2) / Scalar(current_np());
 			//clear
+			m_archive_pool.release(m_archive);
 			m_archive.clear();
 			//init mutation
 			ucb1_init();
@@ -288,10 +296,8 @@ namespace Denn
 			i_output.m_cr = Denn::sature(random(i_target).normal(m_mu_cr[tou_i], 0.1));
 			//P
 			i_output.m_p = random(i_target).uniform(m_pmin, 0.2);
-			//call muation
-			(*ucb1_mutation(i_target))(dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*ucb1_mutation(i_target), *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -326,7 +332,9 @@ namespace Denn
 				Individual::SPtr son = dpopulation.sons()[m_swap_list[i]];
 				//copy
 				if (m_archive_max_size)
-					m_archive.push_back(father->copy());
+				{
+					m_archive.push_back(m_archive_pool.copy(*father, m_archive_precision));
+				}
 				//else if (main_random().uniform() < Scalar(m_archive_max_size) / Scalar(m_archive_max_size + n_discarded))
 				//F
 				sum_f += son->m_f;
@@ -355,7 +363,9 @@ namespace Denn
 			//reduce A
 			while (m_archive_max_size < m_archive.size())
 			{
-				m_archive[main_random().index_rand(m_archive.size())] = m_archive.last();
+				size_t i_remove = main_random().index_rand(m_archive.size());
+				m_archive_pool.release(m_archive[i_remove]);
+				m_archive[i_remove] = m_archive.last();
 				m_archive.pop_back();
 			}
 			/////////////////////////////////////////////////////////////
@@ -379,6 +389,8 @@ namespace Denn
 		std::vector<Scalar> m_mu_f;
 		std::vector<Scalar> m_mu_cr;
 		Population m_archive;
+		IndividualPool m_archive_pool;
+		GenomePrecision     m_archive_precision{ GenomePrecision::GP_FLOAT };
 		Crossover::SPtr m_crossover;
 		std::vector<int> m_swap_list;
 		//////////////////////////////////////////////////////
@@ -74,10 +74,8 @@ namespace Denn
 			size_t method = new_metadata(i_target);
 			//set
 			set_metadata_to_individual(i_target, method, i_output);
-			//call muation
-			(*m_mutations_list[method]) (dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutations_list[method], *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 			//debug
@@ -14,6 +14,7 @@ namespace Denn
 		SHADEMethod(const DennAlgorithm& algorithm) : EvolutionMethod(algorithm)
 		{
 			m_archive_max_size = parameters().m_archive_size;
+			genome_precision_from_string(parameters().m_archive_precision, m_archive_precision);
 			m_h = parameters().m_shade_h;
 		}
 
@@ -25,6 +26,7 @@ namespace Denn
 			m_k = 0;
 			m_pmin = Scalar(2) / Scalar(current_np());
 			//clear
+			m_archive_pool.release(m_archive);
 			m_archive.clear();
 			//create mutation/crossover
 			m_mutation = MutationFactory::create(parameters().m_mutation_type, m_algorithm);
@@ -60,10 +62,8 @@ namespace Denn
 			i_output.m_cr = Denn::sature(random(i_target).normal(m_mu_cr[tou_i], 0.1));
 			//P
 			i_output.m_p = random(i_target).uniform(m_pmin, 0.2);
-			//call muation
-			(*m_mutation) (dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutation, *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -96,7 +96,10 @@ namespace Denn
 				Individual::SPtr father = dpopulation.parents()[i];
 				Individual::SPtr son = dpopulation.sons()[m_swap_list[i]];
 				//copy
-				if (m_archive_max_size) m_archive.push_back(father->copy());
+				if (m_archive_max_size)
+				{
+					m_archive.push_back(m_archive_pool.copy(*father, m_archive_precision));
+				}
 				//else if (main_random().uniform() < Scalar(m_archive_max_size) / Scalar(m_archive_max_size + n_discarded))
 				//F
 				sum_f += son->m_f;
@@ -125,7 +128,9 @@ namespace Denn
 			//reduce A
 			while (m_archive_max_size < m_archive.size())
 			{
-				m_archive[main_random().index_rand(m_archive.size())] = m_archive.last();
+				size_t i_remove = main_random().index_rand(m_archive.size());
+				m_archive_pool.release(m_archive[i_remove]);
+				m_archive[i_remove] = m_archive.last();
 				m_archive.pop_back();
 			}
 			/////////////////////////////////////////////////////////////
@@ -147,6 +152,8 @@ namespace Denn
 		std::vector<Scalar> m_mu_f;
 		std::vector<Scalar> m_mu_cr;
 		Population	        m_archive;
+		IndividualPool	    m_archive_pool;
+		GenomePrecision     m_archive_precision{ GenomePrecision::GP_FLOAT };
 		Mutation::SPtr      m_mutation;
 		Crossover::SPtr     m_crossover;
 		std::vector<int>    m_swap_list;
@@ -161,6 +168,7 @@ namespace Denn
 		L_SHADEMethod(const DennAlgorithm& algorithm) : EvolutionMethod(algorithm)
 		{
 			m_archive_max_size = parameters().m_archive_size;
+			genome_precision_from_string(parameters().m_archive_precision, m_archive_precision);
 			m_h = parameters().m_shade_h;
 		}
 
@@ -172,6 +180,7 @@ namespace Denn
 			m_k = 0;
 			m_pmin = Scalar(2) / Scalar(current_np());
 			//clear
+			m_archive_pool.release(m_archive);
 			m_archive.clear();
 			//NFE to 0
 			m_curr_nfe = 0;
@@ -218,10 +227,8 @@ namespace Denn
 			: Denn::sature(random(i_target).normal(m_mu_cr[tou_i], 0.1));
 			//P
 			i_output.m_p = random(i_target).uniform(m_pmin, 0.2);
-			//call muation
-			(*m_mutation) (dpopulation.parents(), i_target, i_output);
-			//call crossover
-			(*m_crossover)(dpopulation.parents(), i_target, i_output);
+			//call mutation + crossover
+			mutation_crossover(*m_mutation, *m_crossover, dpopulation.parents(), i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -254,7 +261,9 @@ namespace Denn
 				Individual::SPtr son = dpopulation.sons()[m_swap_list[i]];
 				//copy
 				if (m_archive_max_size)
-					m_archive.push_back(father->copy());
+				{
+					m_archive.push_back(m_archive_pool.copy(*father, m_archive_precision));
+				}
 				//F
 				sum_f += son->m_f;
 				sum_f2 += son->m_f * son->m_f;
@@ -322,6 +331,8 @@ namespace Denn
 		std::vector<Scalar> m_mu_f;
 		std::vector<Scalar> m_mu_cr;
 		Population	        m_archive;
+		IndividualPool	    m_archive_pool;
+		GenomePrecision     m_archive_precision{ GenomePrecision::GP_FLOAT };
 		Mutation::SPtr      m_mutation;
 		Crossover::SPtr     m_crossover;
 		std::vector<int>    m_swap_list;
@@ -331,7 +342,9 @@ namespace Denn
 		{
 			while (m_archive_max_size < m_archive.size())
 			{
-				m_archive[main_random().index_rand(m_archive.size())] = m_archive.last();
+				size_t i_remove = main_random().index_rand(m_archive.size());
+				m_archive_pool.release(m_archive[i_remove]);
+				m_archive[i_remove] = m_archive.last();
 				m_archive.pop_back();
 			}
 		}
@@ -34,13 +34,11 @@ namespace Denn
 			//copy
 			i_output.m_f  = target.m_f;
 			i_output.m_cr = target.m_cr;
-            //call mutation
+            //call mutation + crossover
             if(random(i_target).uniform() < Scalar(m_algorithm.parameters().m_trig_m))
-                (*m_trig_mutation) (parents, i_target, i_output);
+                mutation_crossover(*m_trig_mutation, *m_crossover, parents, i_target, i_output);
             else
-                (*m_mutation) (parents, i_target, i_output);
-			//call crossover
-			(*m_crossover)(parents, i_target, i_output);
+                mutation_crossover(*m_mutation, *m_crossover, parents, i_target, i_output);
 			//no 0 wights
 			i_output.m_network.no_0_weights();
 		}
@@ -1,5 +1,7 @@
 #include "Denn/EvolutionMethod.h"
 #include "Denn/Algorithm.h"
+#include "Denn/Mutation.h"
+#include "Denn/Crossover.h"
 #include <algorithm>
 #include <sstream>
 #include <iterator>
@@ -22,6 +24,24 @@ namespace Denn
     bool EvolutionMethod::best_from_validation() { return *parameters().m_use_validation; }
     const VariantRef EvolutionMethod::get_context_data() const { return VariantRef(); }
     
+	//mutation + crossover
+	void EvolutionMethod::mutation_crossover(Mutation& mutation, Crossover& crossover, const Population& population, size_t id_target, Individual& output) const
+	{
+		if (auto element_wise = dynamic_cast<ElementWiseMutation*>(&mutation))
+		{
+			thread_local MutationKernels kernels;
+			element_wise->kernels(population, id_target, output, kernels);
+			//fused
+			if (crossover.fused(population, id_target, kernels, output)) return;
+			//a pass each
+			element_wise->mutate(kernels, output);
+			crossover(population, id_target, output);
+			return;
+		}
+		mutation(population, id_target, output);
+		crossover(population, id_target, output);
+	}
+
 	//easy access
 	const Parameters& EvolutionMethod::parameters()            const { return m_algorithm.parameters();        }
 	const EvolutionMethod& EvolutionMethod::evolution_method() const { return m_algorithm.evolution_method();  }
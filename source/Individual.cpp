@@ -25,7 +25,17 @@ namespace Denn
 		m_cr      = individual.m_cr;
 		m_p        = individual.m_p;
 		m_eval    = individual.m_eval;
-		m_network = individual.m_network;
+		m_network.copy_from(individual.m_network);
+	}
+	void Individual::copy_packed_from(const Individual& individual, GenomePrecision precision)
+	{
+		copy_attributes(individual);
+		m_network.copy_packed_from(individual.m_network, precision);
+	}
+	void Individual::unpack_from(const Individual& individual)
+	{
+		copy_attributes(individual);
+		m_network.unpack_from(individual.m_network);
 	}
 	void Individual::copy_attributes(const Individual& individual)
 	{
@@ -7,6 +7,87 @@ namespace Denn
 	Instance::Instance() {}
 	Instance::Instance(const Denn::Parameters& parameters) {}
 	Instance::~Instance(){ }
+	//cache of sets
+	const DataSetScalar& Instance::validation_set() const
+	{
+		std::unique_lock<std::mutex> lock(m_sets_mutex);
+		//read once
+		if (!m_validation_set)
+		{
+			//kept only if it is read
+			auto set = std::make_unique<DataSetScalar>();
+			if (!dataset_loader().read_validation(*set))
+			{
+				throw std::runtime_error("the validation set of the input file is corrupt");
+			}
+			m_validation_set = std::move(set);
+		}
+		return *m_validation_set;
+	}
+	const DataSetScalar& Instance::test_set() const
+	{
+		std::unique_lock<std::mutex> lock(m_sets_mutex);
+		//read once
+		if (!m_test_set)
+		{
+			//kept only if it is read
+			auto set = std::make_unique<DataSetScalar>();
+			if (!dataset_loader().read_test(*set))
+			{
+				throw std::runtime_error("the test set of the input file is corrupt");
+			}
+			m_test_set = std::move(set);
+		}
+		return *m_test_set;
+	}
+	Instance::DataSetShards Instance::test_shards(size_t n_shards) const
+	{
+		std::unique_lock<std::mutex> lock(m_sets_mutex);
+		//split once
+		if (m_test_shards && m_test_n_shards == n_shards) return m_test_shards;
+		//the whole set, the cached one (it is moved or freed after the split), the last single shard or a new read
+		std::unique_ptr< DataSetScalar > test = std::move(m_test_set);
+		if (!test && m_test_shards && m_test_shards->size() == 1)
+		{
+			test = std::make_unique<DataSetScalar>(m_test_shards->front());
+		}
+		if (!test)
+		{
+			test = std::make_unique<DataSetScalar>();
+			if (!dataset_loader().read_test(*test))
+			{
+				throw std::runtime_error("the test set of the input file is corrupt");
+			}
+		}
+		//at least 2 samples for each shard
+		auto shards = std::make_shared< std::vector<DataSetScalar> >();
+		size_t samples = test->features().cols();
+		size_t n_split = samples < 2 * n_shards ? 1 : n_shards;
+		if (n_split == 1)
+		{
+			shards->push_back(std::move(*test));
+		}
+		else
+		{
+			shards->resize(n_split);
+			for (size_t s = 0; s != n_split; ++s)
+			{
+				size_t start = (s * samples) / n_split;
+				size_t count = ((s + 1) * samples) / n_split - start;
+				DataSetScalar& shard = (*shards)[s];
+				shard.features() = test->features().middleCols(start, count);
+				shard.labels() = test->labels().middleCols(start, count);
+				if (test->sparse()) shard.sparse_features() = test->sparse_features().middleCols(start, count);
+				shard.classes() = test->classes().segment(start, count);
+				shard.m_features_shape = test->m_features_shape;
+				shard.m_labels_shape = test->m_labels_shape;
+			}
+		}
+		//the shards in use are kept by their callers
+		m_test_shards = shards;
+		m_test_n_shards = n_shards;
+		return m_test_shards;
+	}
 	//map
 	static std::map< std::string, InstanceFactory::CreateObject >& i_map()
 	{
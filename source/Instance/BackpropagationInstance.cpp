@@ -32,7 +32,9 @@ namespace Denn
 		{
 			////////////////////////////////////////////////////////////////////////////////////////////////
 			//init
-			m_random_engine.reinit(parameters.m_seed);
+			Random::Generator generator = Random::RG_MT19937;
+			Random::generator_by_name(*parameters.m_random_generator, generator);
+			m_random_engine.reinit(parameters.m_seed, generator);
 			////////////////////////////////////////////////////////////////////////////////////////////////
 			//threads
 			if (!build_thread_pool(m_pool, parameters)) return;
@@ -61,6 +63,12 @@ namespace Denn
 			size_t n_features = m_dataset->get_main_header_info().m_n_features;
 			size_t n_class = m_dataset->get_main_header_info().m_n_classes;
 			m_network = std::get<0>(get_network_from_string(parameters.m_network, n_features, n_class));
+			//sparse features are read only by a fully connected input layer
+			if (m_dataset->get_main_header_info().sparse() && (!m_network.size() || !m_network[0].sparse_input()))
+			{
+				std::cerr << "input file: \"" << *parameters.m_dataset_filename << "\" has sparse features, the first layer must be fully connected!" << std::endl;
+				return; //exit
+			}
 			////////////////////////////////////////////////////////////////////////////////////////////////
 			m_success_init = true;
 		}
@@ -84,7 +92,7 @@ namespace Denn
 		{
 			return  m_dataset && m_dataset->get_main_header_info().m_n_classes == 1 ? 
 					EvaluationFactory::get("binary_cross_entropy")  : 
-					EvaluationFactory::get("cross_entropy");
+					EvaluationFactory::get(*m_parameters.m_fused_loss ? "softmax_cross_entropy" : "cross_entropy");
 
 		}
 
@@ -197,9 +205,9 @@ namespace Denn
 					//update
 					m_network.fit
 					(
-						batch.features(),
-						batch.labels(),
-						sgd
+						batch,
+						sgd,
+						*m_parameters.m_fused_loss ? NeuralNetwork::SOFTMAX_CROSS_ENTROPY : NeuralNetwork::MULTICLASS_CROSS_ENTROPY
 					);
 					//loss update
 					batch_eval = (*loss_function())(m_network, batch);
@@ -213,9 +221,7 @@ namespace Denn
 			}
 			execute_time = Time::get_time() - execute_time;
 			//test
-			DataSetScalar test_set;
-			m_dataset->read_test(test_set);
-			Scalar test_eval = (*test_function())(m_network, test_set);
+			Scalar test_eval = (*test_function())(m_network, this->test_set());
 			//std output
 			output_stream() << "test: " << test_eval << std::endl;
 			output_stream() << "=== BACKPROPAGARION END ===" << std::endl;
@@ -122,7 +122,8 @@ namespace Denn
 			{
                 //get
                 DataSetScalar batch;
-				m_dataset->read_batch(batch);
+				if (!m_dataset->read_batch(batch))
+					throw std::runtime_error("a batch of the input file is corrupt");
 				samples_count += m_dataset->get_last_batch_info().m_n_row;
 			}            
 			output_stream() << "-------------------------" << std::endl;
@@ -141,9 +142,10 @@ namespace Denn
                 output_stream() << "BATCH N[" << c_batch << "]" << std::endl;
                 //getcd 
                 auto batch = dbstream.last_batch();
-                //print
-                for(size_t c = 0; c!=batch.features().cols(); ++c)
+                //print (from the oldest sample of the ring)
+                for(size_t i = 0; i!=batch.features().cols(); ++i)
                 {
+                	size_t c = (dbstream.batch_start() + i) % batch.features().cols();
                 	for(size_t r = 0; r!=batch.features().rows(); ++r)
                     {
                         output_stream() << batch.features()(r,c) << " ";
@@ -171,7 +173,8 @@ namespace Denn
             {
                 //get
                 DataSetScalar batch;
-				m_dataset->read_batch(batch,false);
+				if (!m_dataset->read_batch(batch,false))
+					throw std::runtime_error("a batch of the input file is corrupt");
                 //print batch id
                 output_stream() << "-----------------" << std::endl;
                 output_stream() << "BATCH ID[" << m_dataset->get_last_batch_info().m_batch_id << "]" << std::endl;
@@ -25,11 +25,94 @@ namespace Denn
 	const Layer::Iterator Layer::begin() const { return Iterator(*this, 0); }
 	const Layer::Iterator Layer::end()   const { return Iterator(*this, size()); }
 	///////////////////////////////////////////////////////////////////////////
+	//parameters
+	size_t Layer::parameters_align(size_t size)
+	{
+		//each matrix starts on a 16 bytes boundary (Eigen aligned maps)
+		const size_t align = std::max< size_t >(1, 16 / sizeof(Scalar));
+		return ((size + align - 1) / align) * align;
+	}
+	size_t Layer::parameters_size() const
+	{
+		size_t count = 0;
+		for (size_t i = 0; i != size(); ++i) count += parameters_align((*this)[i].size());
+		return count;
+	}
+	void Layer::parameters_bind(Scalar* buffer)
+	{
+		//no parameters
+		if (!size()) return;
+		//self storage
+		ColVector storage;
+		if (!buffer)
+		{
+			storage.resize(parameters_size());
+			storage.setZero();
+			buffer = storage.data();
+		}
+		//copy
+		Scalar* ptr = buffer;
+		for (size_t i = 0; i != size(); ++i)
+		{
+			auto matrix = (*this)[i];
+			if (matrix.data() && ptr != matrix.data()) AlignedMapMatrix(ptr, matrix.rows(), matrix.cols()) = matrix;
+			ptr += parameters_align(matrix.size());
+		}
+		//remap
+		parameters_map(buffer);
+		//free the old storage
+		m_parameters.swap(storage);
+	}
+	bool Layer::same_layout(const Layer& layer) const
+	{
+		//kind of layer and shapes
+		if (name() != layer.name() || in_size() != layer.in_size() || out_size() != layer.out_size()) return false;
+		//parameters
+		if (size() != layer.size()) return false;
+		//without parameters, compare the metadata (e.g. dropout)
+		if (!size()) return inputs() == layer.inputs();
+		for (size_t i = 0; i != size(); ++i)
+		{
+			if ((*this)[i].rows() != layer[i].rows() || (*this)[i].cols() != layer[i].cols()) return false;
+		}
+		return true;
+	}
+	bool Layer::copy_from(const Layer& layer)
+	{
+		//test
+		if (!same_layout(layer)) return false;
+		//copy
+		for (size_t i = 0; i != size(); ++i) (*this)[i] = layer[i];
+		return true;
+	}
+	void Layer::parameters_release()
+	{
+		//keep the shapes
+		parameters_map(nullptr);
+		m_parameters.resize(0);
+	}
+	void Layer::parameters_alloc()
+	{
+		//get the shapes
+		parameters_map(nullptr);
+		//alloc
+		m_parameters.resize(parameters_size());
+		m_parameters.setZero();
+		//map
+		parameters_map(m_parameters.data());
+	}
+	///////////////////////////////////////////////////////////////////////////
 	//activation
     const Matrix& ActivationLayer::predict(const Matrix& prev_layer_data) 
 	{ 
 		 return feedforward(prev_layer_data); 
 	}
+    const Matrix& ActivationLayer::predict(const Matrix& prev_layer_data, Matrix& top) const
+	{ 
+		top = prev_layer_data;
+		activation_in_place(top);
+		return top;
+	}
     AlignedMapMatrix       ActivationLayer::operator[](size_t i) 
 	{ 
 		denn_assert(0); return AlignedMapMatrix(nullptr, 0, 0); 
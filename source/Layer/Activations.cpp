@@ -1,4 +1,5 @@
 #include "Denn/Layer/Activations.h"
+#include "Denn/Utilities/Transcendental.h"
 
 namespace Denn
 {
@@ -11,11 +12,14 @@ namespace Denn
     }
     const Matrix& Sigmoid::feedforward(const Matrix& bottom) 
     {
-        m_top.resize(bottom.rows(),bottom.cols());
-        m_top.noalias() = (Scalar(1.0) / (Scalar(1.0) + (-bottom).array().exp())).matrix();
+        Transcendental::sigmoid(bottom, m_top);
         //return feed
         return m_top;
     }
+    void Sigmoid::activation_in_place(Matrix& data) const
+    {
+        Transcendental::sigmoid(data);
+    }
     const Matrix& Sigmoid::backpropagate(const Matrix& bottom, const Matrix& grad) 
     {
         CODE_BACKPROPAGATION(
@@ -40,6 +44,10 @@ namespace Denn
         //return feed
         return m_top;
     }
+    void ReLU::activation_in_place(Matrix& data) const
+    {
+        data = data.cwiseMax(0.0);
+    }
     const Matrix& ReLU::backpropagate(const Matrix& bottom, const Matrix& grad)
     {
         CODE_BACKPROPAGATION(
@@ -50,6 +58,31 @@ namespace Denn
         RETURN_BACKPROPAGATION(m_grad_bottom);
     }
     //////////////////////////////////////////////////////////////////////////////////////////////////    
+    Tanh::Tanh(const Shape& shape, const Inputs& inputs) : ActivationLayer("tanh", shape, shape) {}
+    Layer::SPtr Tanh::copy() const
+    {
+        return std::static_pointer_cast<Layer>(std::make_shared<Tanh>(*this));
+    }
+    const Matrix& Tanh::feedforward(const Matrix& bottom)
+    {
+        Transcendental::tanh(bottom, m_top);
+        //return feed
+        return m_top;
+    }
+    void Tanh::activation_in_place(Matrix& data) const
+    {
+        Transcendental::tanh(data);
+    }
+    const Matrix& Tanh::backpropagate(const Matrix& bottom, const Matrix& grad)
+    {
+        CODE_BACKPROPAGATION(
+            // d(a_i)/d(z_i) = 1 - a_i^2
+            Matrix da_dz = Scalar(1.0) - m_top.array().square();
+            m_grad_bottom = grad.cwiseProduct(da_dz);
+        )
+        RETURN_BACKPROPAGATION(m_grad_bottom);
+    }
+    //////////////////////////////////////////////////////////////////////////////////////////////////    
     LeakyReLU::LeakyReLU(const Shape& shape, const Inputs& inputs) : ActivationLayer("leaky_relu", shape, shape)
     {
         m_alpha = inputs.size() ? inputs[0] : 0.01;
@@ -68,6 +101,12 @@ namespace Denn
         //return feed
         return m_top;
     }
+    void LeakyReLU::activation_in_place(Matrix& data) const
+    {
+        data = data.unaryExpr([this](Scalar x) -> Scalar {
+            return Activation::leaky_relu(x,m_alpha);
+        });
+    }
     const Matrix& LeakyReLU::backpropagate(const Matrix& bottom, const Matrix& grad)
     {
         CODE_BACKPROPAGATION(
@@ -87,12 +126,35 @@ namespace Denn
     const Matrix& Softmax::feedforward(const Matrix& bottom)
     { 
         // a = exp(z) / \sum{ exp(z) }
-        m_top = (bottom.rowwise() - bottom.colwise().maxCoeff()).array().exp();
+        if (Transcendental::exact())
+        {
+            m_top = (bottom.rowwise() - bottom.colwise().maxCoeff()).array().exp();
+        }
+        else
+        {
+            m_top = bottom.rowwise() - bottom.colwise().maxCoeff();
+            Transcendental::exp(m_top);
+        }
         RowArray z_exp_sum = m_top.colwise().sum();  // \sum{ exp(z) }
         m_top.array().rowwise() /= z_exp_sum;
         //return feed
         return m_top;
     }
+    void Softmax::activation_in_place(Matrix& data) const
+    {
+        RowVector z_max = data.colwise().maxCoeff();
+        if (Transcendental::exact())
+        {
+            data = (data.rowwise() - z_max).array().exp();
+        }
+        else
+        {
+            data.rowwise() -= z_max;
+            Transcendental::exp(data);
+        }
+        RowArray z_exp_sum = data.colwise().sum();
+        data.array().rowwise() /= z_exp_sum;
+    }
     const Matrix& Softmax::backpropagate(const Matrix& bottom, const Matrix& grad)
     {
         CODE_BACKPROPAGATION(
@@ -16,7 +16,7 @@ namespace Denn
 			  in_channels))
     , m_dim(in_width, in_height, in_channels, window_width, window_height, in_channels, stride, 0, 0)
     {
-
+        m_table.init(m_dim);
     }
     AvgPooling::AvgPooling 
     (
@@ -50,47 +50,17 @@ namespace Denn
 		return feedforward(bottom);
 	}
     const Matrix& AvgPooling::feedforward(const Matrix& bottom)
+    {
+        return predict(bottom, m_top);
+    }
+    const Matrix& AvgPooling::predict(const Matrix& bottom, Matrix& top) const
     {
         int n_sample = bottom.cols();
-        int hw_in = m_dim.in_image_size();
-        int hw_pool = m_dim.pool_size();
-        int hw_out = m_dim.out_image_size();
-        //alloc and init
-        m_top.resize(int(out_size()), n_sample);
-        m_top.setZero(); 
+        //alloc
+        top.resize(int(out_size()), n_sample);
         //avg pooling
-        for (int i = 0; i < n_sample; i ++) 
-        {
-            auto image = bottom.col(i);
-            for (int c = 0; c < m_dim.channel_in; c ++) 
-            {
-                for (int i_out = 0; i_out < hw_out; i_out ++) 
-                {
-                    int step_h = i_out / m_dim.width_out;
-                    int step_w = i_out % m_dim.width_out;
-                    // left-top idx of window in raw image
-                    int start_idx = step_h * m_dim.width_in * m_dim.stride + step_w * m_dim.stride;
-                    for (int i_pool = 0; i_pool < hw_pool; i_pool++) 
-                    {
-                        if (start_idx % m_dim.width_in + i_pool % m_dim.width_kernel >= m_dim.width_in ||
-                            start_idx / m_dim.width_in + i_pool / m_dim.width_kernel >= m_dim.height_in) 
-                        {
-                            continue;  // out of range
-                        }
-                        //index
-                        int pick_idx = start_idx + (i_pool / m_dim.width_kernel) *
-                                       m_dim.width_in + i_pool % m_dim.width_kernel + c * hw_in;
-                        //test
-                        if (image(pick_idx) >= m_top(c * hw_out + i_out, i)) 
-                        {  // max pooling
-                            m_top(c * hw_out + i_out, i) += image(pick_idx);
-                        }
-                    }
-                    m_top(c * hw_out + i_out, i) /= hw_pool;
-                }
-            }
-        }
-        return m_top;
+        internal::avg_pooling(m_dim, m_table, bottom, top);
+        return top;
     }
     
     const Matrix& AvgPooling::backpropagate(const Matrix& bottom, const Matrix& grad) 
@@ -109,24 +79,13 @@ namespace Denn
             {
                 for (int c = 0; c < m_dim.channel_in; c ++) 
                 {
-                    for (int i_out = 0; i_out < hw_out; i_out ++) 
+                    const int* window = m_table.m_index.data();
+                    for (int i_out = 0; i_out < hw_out; i_out ++, window += hw_pool) 
                     {
-                        int step_h = i_out / m_dim.width_out;
-                        int step_w = i_out % m_dim.width_out;
-                        // left-top idx of window in raw image
-                        int start_idx = step_h * m_dim.width_in * m_dim.stride + step_w * m_dim.stride;
                         for (int i_pool = 0; i_pool < hw_pool; i_pool++) 
                         {
-                            if (start_idx % m_dim.width_in + i_pool % m_dim.width_kernel >= m_dim.width_in ||
-                                start_idx / m_dim.width_in + i_pool / m_dim.width_kernel >= m_dim.height_in) 
-                            {
-                                continue;  // out of range
-                            }
-                            //index
-                            int pick_idx = start_idx + (i_pool / m_dim.width_kernel) *
-                                        m_dim.width_in + i_pool % m_dim.width_kernel + c * hw_in;
-                            //test
-                            m_grad_bottom(pick_idx, i) += grad(c * hw_out + i_out, i) / hw_pool;
+                            if (window[i_pool] < 0) continue;  // out of range
+                            m_grad_bottom(c * hw_in + window[i_pool], i) += grad(c * hw_out + i_out, i) / hw_pool;
                         }
                     }
                 }
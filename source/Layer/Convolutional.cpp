@@ -1,4 +1,5 @@
 #include "Denn/Layer/Convolutional.h"
+#include "Denn/Layer/MaxPooling.h"
 #define _metadata(_x, _default) (_x < metadata.size() ? metadata[_x] : _default)
 #define _convshape(in, kernel, stride, pad) (1 + (in - kernel + 2 * pad) / stride)
 namespace Denn
@@ -10,7 +11,23 @@ namespace Denn
 	, int window_width, int window_height, int out_channels
 	, int stride, int pad_w, int pad_h
 	)
-	: DerivableLayer("convolutional",
+	: Convolutional
+	(
+	  "convolutional"
+	, in_width, in_height, in_channels
+	, window_width, window_height, out_channels
+	, stride, pad_w, pad_h
+	)
+	{
+	}
+	Convolutional::Convolutional
+	(
+	  const std::string& name
+	, int in_width, int in_height, int in_channels
+	, int window_width, int window_height, int out_channels
+	, int stride, int pad_w, int pad_h
+	)
+	: DerivableLayer(name,
 		Shape(in_width, in_height, in_channels),
 		Shape(_convshape(in_width, window_width, stride, pad_w), 
 			  _convshape(in_height, window_height, stride, pad_h),
@@ -18,8 +35,7 @@ namespace Denn
 	, m_dim(in_width, in_height, in_channels, window_width, window_height, out_channels, stride, pad_w, pad_h)
 	{
 		// Set data dimension
-		m_kernels.resize(m_dim.kernel_size(), m_dim.channel_out);
-		m_bias.resize(m_dim.channel_out);
+		parameters_alloc();
 		// Backpropagation
 		CODE_BACKPROPAGATION(
 			m_grad_bias.resize(m_dim.channel_out);
@@ -41,6 +57,19 @@ namespace Denn
 	)
 	{
 	}
+	Convolutional::Convolutional(const Convolutional& layer)
+	: DerivableLayer(layer)
+	, m_dim(layer.m_dim)
+	{
+		//own storage, then the parameters of layer (released if its genome is packed)
+		parameters_alloc();
+		if (layer.m_kernels.data()) copy_from(layer);
+		// Backpropagation
+		CODE_BACKPROPAGATION(
+			m_grad_bias = layer.m_grad_bias;
+			m_grad_kernels = layer.m_grad_kernels;
+		)
+	}
 	//////////////////////////////////////////////////
 	const Inputs Convolutional::inputs() const
 	{
@@ -52,55 +81,191 @@ namespace Denn
 	//////////////////////////////////////////////////
 	Layer::SPtr Convolutional::copy() const
 	{
-		return std::static_pointer_cast<Layer>(std::make_shared<Convolutional>(*this));
+		auto layer = std::make_shared<Convolutional>(*this);
+		return std::static_pointer_cast<Layer>(layer);
+	}
+	bool Convolutional::same_layout(const Layer& layer) const
+	{
+		auto conv = dynamic_cast<const Convolutional*>(&layer);
+		return conv && conv->m_dim == m_dim && Layer::same_layout(layer);
+	}
+	void Convolutional::parameters_map(Scalar* buffer)
+	{
+		const int kernels_size = m_dim.kernel_size() * m_dim.channel_out;
+		//kernels(kernel_size x out_channels), bias(out_channels x 1)
+		new (&m_kernels) AlignedMapMatrix(buffer, m_dim.kernel_size(), m_dim.channel_out);
+		new (&m_bias) AlignedMapColVector(buffer ? buffer + parameters_align(kernels_size) : nullptr, m_dim.channel_out);
 	}
 	//////////////////////////////////////////////////
 	const Matrix& Convolutional::predict(const Matrix& bottom)
 	{
-			// Each column is an observation
-			int n_sample = bottom.cols();
-			m_top.resize(int(out_size()), n_sample);
-			//Buffer
-			thread_local Matrix image;
-			//for each
-			for (int i = 0; i < n_sample; i++) 
-			{
-				// im2col
-				internal::img_to_col(m_dim, bottom.col(i), image);
-				// conv by product
-				AlignedMapMatrix result(m_top.col(i).data(), image.rows(), m_kernels.cols());
-				result.noalias() = image * m_kernels;
-				result.rowwise() += m_bias.transpose();
-			}
-			return m_top;
+		return convolution(bottom, nullptr, m_top, nullptr);
 	}
 	const Matrix& Convolutional::feedforward(const Matrix& bottom)
+	{
+		std::vector<Matrix>* images = nullptr;
+		CODE_BACKPROPAGATION(images = &m_images;)
+		return convolution(bottom, nullptr, m_top, images);
+	}
+	const Matrix& Convolutional::predict(const Matrix& bottom, Matrix& top) const
+	{
+		return convolution(bottom, nullptr, top, nullptr);
+	}
+	int Convolutional::samples_per_tile() const
+	{
+		//~1M values of im2col for each product
+		return std::max(1, (1 << 20) / std::max(1, m_dim.out_image_size() * m_dim.kernel_size()));
+	}
+	template < typename Output >
+	void Convolutional::convolution_tiles(const Matrix& bottom, internal::Im2ColCache* cache, std::vector<Matrix>* save_images, Output&& output) const
 	{
 		// Each column is an observation
 		int n_sample = bottom.cols();
-		m_top.resize(int(out_size()), n_sample);
+		int hw_out = m_dim.out_image_size();
 		//backpropagation buffer
-		CODE_BACKPROPAGATION(
-			m_images.resize(n_sample);
-		)
-		//Buffer
-        thread_local Matrix image;
-		//for each
-		for (int i = 0; i < n_sample; i++) 
+		if (save_images) save_images->resize(n_sample);
+		//Buffers
+		thread_local Matrix images;
+		thread_local Matrix result;
+		//input shared by all the networks, lowered once
+		auto shared = cache ? cache->get(m_dim, bottom) : nullptr;
+		int shared_samples = shared ? int(shared->rows() / hw_out) : 0;
+		//tiles of samples
+		int tile = samples_per_tile();
+		for (int start = 0; start < n_sample; start += tile)
 		{
-			// im2col
-			internal::img_to_col(m_dim, bottom.col(i), image);
+			int count = std::min(tile, n_sample - start);
+			// im2col of the tile (if the tile is not cached)
+			bool tile_shared = start + count <= shared_samples;
+			if (!tile_shared) internal::img_to_col(m_dim, bottom, start, count, images);
+			auto tile_images = tile_shared ? shared->middleRows(start * hw_out, count * hw_out) 
+										   : static_cast<const Matrix&>(images).middleRows(0, count * hw_out);
 			//save for backpropagation pass
-			CODE_BACKPROPAGATION(
-				m_images[i] = image;
-			)
-			// conv by product
-			AlignedMapMatrix result(m_top.col(i).data(), image.rows(), m_kernels.cols());
-			result.noalias() = image * m_kernels;
-			result.rowwise() += m_bias.transpose();
+			if (save_images)
+			for (int s = 0; s < count; ++s)
+				(*save_images)[start + s] = tile_images.middleRows(s * hw_out, hw_out);
+			// conv of the tile by a single product
+			result.noalias() = tile_images * m_kernels;
+			// output of each sample (hw_out x channel_out, without bias)
+			for (int s = 0; s < count; ++s)
+			{
+				output(start + s, result.middleRows(s * hw_out, hw_out));
+			}
 		}
+	}
+	const Matrix& Convolutional::convolution(const Matrix& bottom, internal::Im2ColCache* cache, Matrix& top, std::vector<Matrix>* save_images) const
+	{
+		int hw_out = m_dim.out_image_size();
+		int channel_out = m_dim.channel_out;
+		top.resize(int(out_size()), bottom.cols());
+		convolution_tiles(bottom, cache, save_images, [&](int sample, const Eigen::Block<Matrix>& result)
+		{
+			// output layout + bias
+			MapMatrix sample_top(top.col(sample).data(), hw_out, channel_out);
+			sample_top.noalias() = result.rowwise() + m_bias.transpose();
+		});
 		//return
-		return m_top;
+		return top;
+	}
+	const Matrix& Convolutional::cached_predict(const Matrix& bottom, internal::Im2ColCache& cache, const std::vector<Layer*>& fused_layers, bool quantized, Matrix& top) const
+	{
+		if (fused_layers.size()) return fused_convolution(bottom, &cache, fused_layers, top);
+		return convolution(bottom, &cache, top, nullptr);
+	}
+	size_t Convolutional::fusion(const std::vector<Layer*>& next_layers) const
+	{
+		//conv + activation
+		if (!next_layers.size() || !dynamic_cast<ActivationLayer*>(next_layers[0])) return 0;
+		//conv + activation + max pooling
+		if (next_layers.size() > 1)
+		{
+			auto pooling = dynamic_cast<MaxPooling*>(next_layers[1]);
+			if (pooling && pooling->in_size() == out_size()) return 2;
+		}
+		return 1;
+	}
+	const Matrix& Convolutional::fused_predict(const Matrix& bottom, const std::vector<Layer*>& fused_layers, Matrix& top) const
+	{
+		return fused_convolution(bottom, nullptr, fused_layers, top);
+	}
+	const Matrix& Convolutional::fused_convolution(const Matrix& bottom, internal::Im2ColCache* cache, const std::vector<Layer*>& fused_layers, Matrix& top) const
+	{
+		auto activation = static_cast<const ActivationLayer*>(fused_layers[0]);
+		//conv + activation
+		if (fused_layers.size() == 1)
+		{
+			convolution(bottom, cache, top, nullptr);
+			activation->activation_in_place(top);
+			return top;
+		}
+		//conv + activation + max pooling, sample by sample (the conv output is never stored)
+		auto pooling = static_cast<const MaxPooling*>(fused_layers[1]);
+		int hw_out = m_dim.out_image_size();
+		int channel_out = m_dim.channel_out;
+		top.resize(int(pooling->out_size()), bottom.cols());
+		thread_local Matrix image;
+		image.resize(int(out_size()), 1);
+		convolution_tiles(bottom, cache, nullptr, [&](int sample, const Eigen::Block<Matrix>& result)
+		{
+			MapMatrix sample_image(image.data(), hw_out, channel_out);
+			sample_image.noalias() = result.rowwise() + m_bias.transpose();
+			activation->activation_in_place(image);
+			pooling->pooling(image.data(), top.col(sample).data());
+		});
+		return top;
+	}
+	bool Convolutional::population_feedforward(const std::vector<Layer*>& layers, const Matrix& bottom, internal::Im2ColCache* cache)
+	{
+		//all the layers must have the same layout
+		for (Layer* layer : layers)
+		{
+			auto conv = dynamic_cast<Convolutional*>(layer);
+			if (!conv || !(conv->m_dim == m_dim)) return false;
+		}
+		// Each column is an observation
+		int n_sample = bottom.cols();
+		int n_layers = int(layers.size());
+		int hw_out = m_dim.out_image_size();
+		int channel_out = m_dim.channel_out;
+		//Buffers
+		thread_local Matrix images;
+		thread_local Matrix kernels;
+		thread_local Matrix result;
+		//stack all kernels, [K_0 K_1 ... K_n]
+		kernels.resize(m_kernels.rows(), channel_out * n_layers);
+		for (int l = 0; l < n_layers; ++l)
+		{
+			auto conv = static_cast<Convolutional*>(layers[l]);
+			kernels.middleCols(l * channel_out, channel_out) = conv->m_kernels;
+			conv->m_top.resize(int(conv->out_size()), n_sample);
+		}
+		//input shared by all the networks, lowered once
+		auto shared = cache ? cache->get(m_dim, bottom) : nullptr;
+		int shared_samples = shared ? int(shared->rows() / hw_out) : 0;
+		//tiles of samples
+		int tile = samples_per_tile();
+		for (int start = 0; start < n_sample; start += tile)
+		{
+			int count = std::min(tile, n_sample - start);
+			// im2col, once for all the layers (if the tile is not cached)
+			bool tile_shared = start + count <= shared_samples;
+			if (!tile_shared) internal::img_to_col(m_dim, bottom, start, count, images);
+			auto tile_images = tile_shared ? shared->middleRows(start * hw_out, count * hw_out) 
+										   : static_cast<const Matrix&>(images).middleRows(0, count * hw_out);
+			// conv of all layers by a single product
+			result.noalias() = tile_images * kernels;
+			// scatter
+			for (int l = 0; l < n_layers; ++l)
+			{
+				auto conv = static_cast<Convolutional*>(layers[l]);
+				for (int s = 0; s < count; ++s)
+				{
+					MapMatrix top(conv->m_top.col(start + s).data(), hw_out, channel_out);
+					top.noalias() = result.block(s * hw_out, l * channel_out, hw_out, channel_out).rowwise() + conv->m_bias.transpose();
+				}
+			}
+		}
+		return true;
 	}
 	const Matrix&  Convolutional::backpropagate(const Matrix& bottom, const Matrix& grad)
 	{
@@ -131,13 +296,11 @@ namespace Denn
 	void Convolutional::update(const Optimizer& optimize)
 	{
 		CODE_BACKPROPAGATION(
-			AlignedMapColVector  w(m_kernels.data(), m_kernels.size());
-			AlignedMapColVector  b(m_bias.data(), m_bias.size());
 			ConstAlignedMapColVector dw(m_grad_kernels.data(), m_grad_kernels.size());
 			ConstAlignedMapColVector db(m_grad_bias.data(), m_grad_bias.size());
 
-			optimize.update(w, dw);
-			optimize.update(b, db);
+			optimize.update(AlignedMapColVector(m_kernels.data(), m_kernels.size()), dw);
+			optimize.update(AlignedMapColVector(m_bias.data(), m_bias.size()), db);
 		)
 		BACKPROPAGATION_ASSERT
 	}
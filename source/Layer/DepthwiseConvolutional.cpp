@@ -0,0 +1,186 @@
+#include "Denn/Layer/DepthwiseConvolutional.h"
+#define _metadata(_x, _default) (_x < metadata.size() ? metadata[_x] : _default)
+#define _convshape(in, kernel, stride, pad) (1 + (in - kernel + 2 * pad) / stride)
+namespace Denn
+{
+	///////////////////////////////////////
+	DepthwiseConvolutional::DepthwiseConvolutional
+	(
+	  int in_width, int in_height, int in_channels
+	, int window_width, int window_height
+	, int stride, int pad_w, int pad_h
+	)
+	: DerivableLayer("depthwise_convolutional",
+		Shape(in_width, in_height, in_channels),
+		Shape(_convshape(in_width, window_width, stride, pad_w),
+			  _convshape(in_height, window_height, stride, pad_h),
+			  in_channels))
+	, m_dim(in_width, in_height, in_channels, window_width, window_height, in_channels, stride, pad_w, pad_h)
+	{
+		// Windows
+		m_table.init(m_dim);
+		// Set data dimension
+		parameters_alloc();
+		// Backpropagation
+		CODE_BACKPROPAGATION(
+			m_grad_bias.resize(m_dim.channel_in);
+			m_grad_kernels.resize(m_dim.pool_size(), m_dim.channel_in);
+		)
+	}
+	DepthwiseConvolutional::DepthwiseConvolutional
+	(
+		  const Shape& in
+		, const Inputs& metadata
+	)
+	: DepthwiseConvolutional
+	(
+	//shapes
+	  in.width(), in.height(), in.channels()
+	//inputs
+	, metadata[0], metadata[1]
+	, _metadata(2, 1), _metadata(3, 0), _metadata(4, 0)
+	)
+	{
+	}
+	DepthwiseConvolutional::DepthwiseConvolutional(const DepthwiseConvolutional& layer)
+	: DerivableLayer(layer)
+	, m_dim(layer.m_dim)
+	, m_table(layer.m_table)
+	{
+		//same parameters (parameters_bind copies them)
+		parameters_map(const_cast<Scalar*>(layer.m_kernels.data()));
+		// Backpropagation
+		CODE_BACKPROPAGATION(
+			m_grad_bias = layer.m_grad_bias;
+			m_grad_kernels = layer.m_grad_kernels;
+		)
+	}
+	//////////////////////////////////////////////////
+	const Inputs DepthwiseConvolutional::inputs() const
+	{
+		return make_inputs<int>({
+			m_dim.width_kernel, m_dim.height_kernel,
+			m_dim.stride, m_dim.pad_w, m_dim.pad_h
+		});
+	}
+	//////////////////////////////////////////////////
+	Layer::SPtr DepthwiseConvolutional::copy() const
+	{
+		auto layer = std::make_shared<DepthwiseConvolutional>(*this);
+		layer->parameters_bind();
+		return std::static_pointer_cast<Layer>(layer);
+	}
+	bool DepthwiseConvolutional::same_layout(const Layer& layer) const
+	{
+		auto conv = dynamic_cast<const DepthwiseConvolutional*>(&layer);
+		return conv && conv->m_dim == m_dim && Layer::same_layout(layer);
+	}
+	void DepthwiseConvolutional::parameters_map(Scalar* buffer)
+	{
+		const int kernels_size = m_dim.pool_size() * m_dim.channel_in;
+		//kernels(filter_size x channels), bias(channels x 1)
+		new (&m_kernels) AlignedMapMatrix(buffer, m_dim.pool_size(), m_dim.channel_in);
+		new (&m_bias) AlignedMapColVector(buffer ? buffer + parameters_align(kernels_size) : nullptr, m_dim.channel_in);
+	}
+	//////////////////////////////////////////////////
+	const Matrix& DepthwiseConvolutional::predict(const Matrix& bottom)
+	{
+		return predict(bottom, m_top);
+	}
+	const Matrix& DepthwiseConvolutional::feedforward(const Matrix& bottom)
+	{
+		return predict(bottom, m_top);
+	}
+	const Matrix& DepthwiseConvolutional::predict(const Matrix& bottom, Matrix& top) const
+	{
+		top.resize(int(out_size()), bottom.cols());
+		internal::depthwise_convolution(m_dim, m_table, m_kernels.data(), m_bias.data(), bottom, top);
+		return top;
+	}
+	size_t DepthwiseConvolutional::fusion(const std::vector<Layer*>& next_layers) const
+	{
+		//conv + activation
+		return next_layers.size() && dynamic_cast<ActivationLayer*>(next_layers[0]) ? 1 : 0;
+	}
+	const Matrix& DepthwiseConvolutional::fused_predict(const Matrix& bottom, const std::vector<Layer*>& fused_layers, Matrix& top) const
+	{
+		auto activation = static_cast<const ActivationLayer*>(fused_layers[0]);
+		predict(bottom, top);
+		activation->activation_in_place(top);
+		return top;
+	}
+	const Matrix& DepthwiseConvolutional::backpropagate(const Matrix& bottom, const Matrix& grad)
+	{
+		CODE_BACKPROPAGATION(
+			int n_sample = bottom.cols();
+			int hw_in = m_dim.in_image_size();
+			int hw_pool = m_dim.pool_size();
+			int hw_out = m_dim.out_image_size();
+			m_grad_kernels.setZero();
+			m_grad_bias.setZero();
+			m_grad_bottom.resize(int(in_size()), n_sample);
+			m_grad_bottom.setZero();
+			for (int i = 0; i < n_sample; i++)
+			{
+				for (int c = 0; c < m_dim.channel_in; c++)
+				{
+					const Scalar* in = bottom.col(i).data() + c * hw_in;
+					const Scalar* grad_top = grad.col(i).data() + c * hw_out;
+					Scalar* grad_in = m_grad_bottom.col(i).data() + c * hw_in;
+					const int* window = m_table.m_index.data();
+					for (int i_out = 0; i_out < hw_out; i_out++, window += hw_pool)
+					{
+						// d(L)/d(b) = \sum{ d(L)/d(z_i) }
+						m_grad_bias(c) += grad_top[i_out];
+						for (int i_pool = 0; i_pool < hw_pool; i_pool++)
+						{
+							if (window[i_pool] < 0) continue;  // padding
+							// d(L)/d(w) = \sum{ d(L)/d(z_i) * x_i }
+							m_grad_kernels(i_pool, c) += grad_top[i_out] * in[window[i_pool]];
+							// d(L)/d(x) = \sum{ d(L)/d(z_i) * w }
+							grad_in[window[i_pool]] += grad_top[i_out] * m_kernels(i_pool, c);
+						}
+					}
+				}
+			}
+		)
+		RETURN_BACKPROPAGATION(m_grad_bottom);
+	}
+	void DepthwiseConvolutional::update(const Optimizer& optimize)
+	{
+		CODE_BACKPROPAGATION(
+			ConstAlignedMapColVector dw(m_grad_kernels.data(), m_grad_kernels.size());
+			ConstAlignedMapColVector db(m_grad_bias.data(), m_grad_bias.size());
+
+			optimize.update(AlignedMapColVector(m_kernels.data(), m_kernels.size()), dw);
+			optimize.update(AlignedMapColVector(m_bias.data(), m_bias.size()), db);
+		)
+		BACKPROPAGATION_ASSERT
+	}
+	//////////////////////////////////////////////////
+	size_t DepthwiseConvolutional::size() const
+	{
+		return 2;
+	}
+	AlignedMapMatrix DepthwiseConvolutional::operator[](size_t i)
+	{
+		denn_assert(i < 2);
+		switch (i)
+		{
+			default:
+			case 0: return  AlignedMapMatrix(m_kernels.data(), m_kernels.rows(), m_kernels.cols());
+			case 1: return  AlignedMapMatrix(m_bias.data(), m_bias.rows(), m_bias.cols());
+		}
+	}
+	ConstAlignedMapMatrix DepthwiseConvolutional::operator[](size_t i) const
+	{
+		denn_assert(i < 2);
+		switch (i)
+		{
+			default:
+			case 0: return  ConstAlignedMapMatrix(m_kernels.data(), m_kernels.rows(), m_kernels.cols());
+			case 1: return  ConstAlignedMapMatrix(m_bias.data(), m_bias.rows(), m_bias.cols());
+		}
+	}
+	//////////////////////////////////////////////////
+}
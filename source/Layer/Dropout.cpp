@@ -62,9 +62,10 @@ namespace Denn
         //Get random engine from network
         denn_assert(network());
         denn_assert(network()->random());
-        //random
+        //random, drawn in bulk then thresholded
+        network()->random()->uniform_fill(m_mask.data(), m_mask.size());
         m_mask = m_mask.unaryExpr([this](const Scalar& x) -> Scalar  { 
-            return network()->random()->uniform() < m_probability ? Scalar(0) : Scalar(1); 
+            return x < m_probability ? Scalar(0) : Scalar(1); 
         });
         //apply
         m_top = (bottom.array() * m_mask.array()).matrix();
@@ -72,6 +73,27 @@ namespace Denn
         return m_top;
     }
     
+    const Matrix& Dropout::predict(const Matrix& bottom, Matrix& top) const
+    {
+        //identity
+        return bottom;
+    }
+    const Matrix& Dropout::feedforward(const Matrix& bottom, Matrix& top) const
+    {
+        //Get random engine from network
+        denn_assert(network());
+        denn_assert(network()->random());
+        //random mask, applied on the fly (not stored)
+        //the uniforms are drawn in bulk into top (top is never the bottom)
+        top.resize(bottom.rows(), bottom.cols());
+        network()->random()->uniform_fill(top.data(), top.size());
+        top = bottom.binaryExpr(top, [this](const Scalar& x, const Scalar& u) -> Scalar  { 
+            return x * (u < m_probability ? Scalar(0) : Scalar(1)); 
+        });
+        //return 
+        return top;
+    }
+    
     const Matrix& Dropout::backpropagate(const Matrix& bottom, const Matrix& grad) 
     {
         CODE_BACKPROPAGATION(
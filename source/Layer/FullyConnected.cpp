@@ -10,11 +10,8 @@ namespace Denn
 	)
 	: DerivableLayer("fully_connected",{ features }, { clazz })
 	{
-		//weight
-		m_weight.resize(int(this->m_in_size), int(this->m_out_size));
-		m_weight.setZero();
-		m_bias.resize(int(this->m_out_size));
-		m_bias.setZero();
+		//weight and bias
+		parameters_alloc();
 		//derivate
 		CODE_BACKPROPAGATION(
 			m_grad_w.resize(int(this->m_in_size), int(this->m_out_size));
@@ -31,6 +28,18 @@ namespace Denn
 	: FullyConnected(in.size3D(), metadata[0])
 	{
 	}
+	FullyConnected::FullyConnected(const FullyConnected& layer)
+	: DerivableLayer(layer)
+	{
+		//own storage, then the parameters of layer (released if its genome is packed)
+		parameters_alloc();
+		if (layer.m_weight.data()) copy_from(layer);
+		//derivate
+		CODE_BACKPROPAGATION(
+			m_grad_w = layer.m_grad_w;
+			m_grad_b = layer.m_grad_b;
+		)
+	}
 	//////////////////////////////////////////////////
 	const Inputs FullyConnected::inputs() const
 	{
@@ -39,23 +48,122 @@ namespace Denn
 	//////////////////////////////////////////////////
 	Layer::SPtr FullyConnected::copy() const
 	{
-		return std::static_pointer_cast<Layer>(std::make_shared<FullyConnected>(*this));
+		auto layer = std::make_shared<FullyConnected>(*this);
+		return std::static_pointer_cast<Layer>(layer);
+	}
+	void FullyConnected::parameters_map(Scalar* buffer)
+	{
+		const int in = int(this->m_in_size);
+		const int out = int(this->m_out_size);
+		//W(in_size x out_size), b(out_size x 1)
+		new (&m_weight) AlignedMapMatrix(buffer, in, out);
+		new (&m_bias) AlignedMapColVector(buffer ? buffer + parameters_align(in * out) : nullptr, out);
 	}
 
 	//////////////////////////////////////////////////
 	const Matrix& FullyConnected::predict(const Matrix& bottom)
 	{
-		return feedforward(bottom);
+		return predict(bottom, m_top);
 	}
 	const Matrix& FullyConnected::feedforward(const Matrix& bottom)
+	{
+		return predict(bottom, m_top);
+	}
+	const Matrix& FullyConnected::predict(const Matrix& bottom, Matrix& top) const
 	{
 		const int n_sample = bottom.cols();
 		// top = w' * x + b
-		m_top.resize(int(out_size()), n_sample);
-		m_top.noalias() = m_weight.transpose() * bottom;
-		m_top.colwise() += m_bias;
+		top.resize(int(out_size()), n_sample);
+		top.noalias() = m_weight.transpose() * bottom;
+		top.colwise() += m_bias;
+		//return value
+		return top;
+	}
+	bool FullyConnected::population_feedforward(const std::vector<Layer*>& layers, const Matrix& bottom, internal::Im2ColCache* cache)
+	{
+		//all the layers must have the same shape
+		for (Layer* layer : layers)
+		{
+			auto fc = dynamic_cast<FullyConnected*>(layer);
+			if (!fc || fc->m_weight.rows() != m_weight.rows() || fc->m_weight.cols() != m_weight.cols()) return false;
+		}
+		//sizes
+		const int n_sample = bottom.cols();
+		const int n_layers = int(layers.size());
+		const int out = int(out_size());
+		//Buffers
+		thread_local Matrix weights;
+		thread_local Matrix top;
+		//stack all weights, [W_0 W_1 ... W_n]
+		weights.resize(m_weight.rows(), out * n_layers);
+		for (int l = 0; l < n_layers; ++l)
+		{
+			weights.middleCols(l * out, out) = static_cast<FullyConnected*>(layers[l])->m_weight;
+		}
+		// [top_0' top_1' ... top_n']' = [W_0 W_1 ... W_n]' * x
+		top.resize(out * n_layers, n_sample);
+		top.noalias() = weights.transpose() * bottom;
+		//scatter, top_l += b_l
+		for (int l = 0; l < n_layers; ++l)
+		{
+			auto fc = static_cast<FullyConnected*>(layers[l]);
+			fc->m_top.resize(out, n_sample);
+			fc->m_top.noalias() = top.middleRows(l * out, out);
+			fc->m_top.colwise() += fc->m_bias;
+		}
+		//return value
+		return true;
+	}
+	size_t FullyConnected::fusion(const std::vector<Layer*>& next_layers) const
+	{
+		//fc + activation
+		return next_layers.size() && dynamic_cast<ActivationLayer*>(next_layers[0]) ? 1 : 0;
+	}
+	const Matrix& FullyConnected::fused_predict(const Matrix& bottom, const std::vector<Layer*>& fused_layers, Matrix& top) const
+	{
+		auto activation = static_cast<const ActivationLayer*>(fused_layers[0]);
+		// top = f(w' * x + b)
+		predict(bottom, top);
+		activation->activation_in_place(top);
+		//return value
+		return top;
+	}
+	const Matrix& FullyConnected::quantized_predict(const Matrix& bottom, Matrix& top) const
+	{
+		return quantized_fully_connected(bottom, nullptr, top);
+	}
+	const Matrix& FullyConnected::cached_predict(const Matrix& bottom, internal::Im2ColCache& cache, const std::vector<Layer*>& fused_layers, bool quantized, Matrix& top) const
+	{
+		if (quantized)			 return quantized_fully_connected(bottom, &cache, top);
+		if (fused_layers.size()) return fused_predict(bottom, fused_layers, top);
+		return predict(bottom, top);
+	}
+	const Matrix& FullyConnected::quantized_fully_connected(const Matrix& bottom, const internal::Im2ColCache* cache, Matrix& top) const
+	{
+		//int8 operands, a scale for each output and for each sample
+		thread_local internal::QuantizedMatrix weight;
+		thread_local internal::QuantizedMatrix input;
+		weight.quantize(m_weight);
+		//a shared input (e.g. the batch) is quantized once by each thread, until it changes
+		thread_local internal::QuantizedMatrix shared_input;
+		thread_local size_t shared_revision{ 0 };
+		const internal::QuantizedMatrix* quantized_input = &input;
+		if (cache)
+		{
+			size_t revision = cache->revision();
+			if (revision != shared_revision) shared_input.quantize(bottom);
+			shared_revision = revision;
+			quantized_input = &shared_input;
+		}
+		else
+		{
+			input.quantize(bottom);
+		}
+		// top ~ w' * x + b
+		internal::quantized_product(weight, *quantized_input, top);
+		top.colwise() += m_bias;
 		//return value
-		return m_top;
+		return top;
 	}
 	const Matrix&  FullyConnected::backpropagate(const Matrix& bottom, const Matrix& grad)
     {
@@ -72,16 +180,32 @@ namespace Denn
 		)
 		RETURN_BACKPROPAGATION(m_grad_bottom);
     }
+	const Matrix& FullyConnected::sparse_predict(const SparseMatrix& bottom, Matrix& top) const
+	{
+		// top = w' * x + b, by the nonzeros of x
+		internal::sparse_fully_connected(bottom, m_weight, m_bias, top);
+		return top;
+	}
+	const Matrix& FullyConnected::sparse_backpropagate(const SparseMatrix& bottom, const Matrix& grad)
+	{
+		CODE_BACKPROPAGATION(
+			// d(L)/d(w') = d(L)/d(z) * x', by the nonzeros of x
+			// d(L)/d(b) = \sum{ d(L)/d(z_i) }
+			internal::sparse_fully_connected_gradient(bottom, grad, m_grad_w);
+			m_grad_b = grad.rowwise().sum();
+			//no gradient of the input
+			m_grad_bottom.resize(0, grad.cols());
+		)
+		RETURN_BACKPROPAGATION(m_grad_bottom);
+	}
 	void FullyConnected::update(const Optimizer& optimize)
 	{
 		CODE_BACKPROPAGATION(
-			AlignedMapColVector  w(m_weight.data(), m_weight.size());
-			AlignedMapColVector  b(m_bias.data(), m_bias.size());
 			ConstAlignedMapColVector dw(m_grad_w.data(), m_grad_w.size());
 			ConstAlignedMapColVector db(m_grad_b.data(), m_grad_b.size());
 
-			optimize.update(w, dw);
-			optimize.update(b, db);
+			optimize.update(AlignedMapColVector(m_weight.data(), m_weight.size()), dw);
+			optimize.update(AlignedMapColVector(m_bias.data(), m_bias.size()), db);
 		)
 		BACKPROPAGATION_ASSERT
 	}
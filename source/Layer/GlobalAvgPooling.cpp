@@ -0,0 +1,75 @@
+#include "Denn/Layer/GlobalAvgPooling.h"
+
+namespace Denn
+{
+    GlobalAvgPooling::GlobalAvgPooling
+    (
+      int in_width, int in_height, int in_channels
+    )
+	: PoolingLayer("global_avg_pooling",
+		Shape(in_width, in_height, in_channels),
+		Shape(in_channels))
+    {
+    }
+    GlobalAvgPooling::GlobalAvgPooling
+    (
+      const Shape& in
+    , const Inputs& metadata
+    )
+	: GlobalAvgPooling(in.width(), in.height(), in.channels())
+    {
+    }
+    //////////////////////////////////////////////////
+	Layer::SPtr GlobalAvgPooling::copy() const
+	{
+		return std::static_pointer_cast<Layer>(std::make_shared<GlobalAvgPooling>(*this));
+	}
+	const Inputs GlobalAvgPooling::inputs() const
+	{
+		return {};
+	}
+    //////////////////////////////////////////////////
+	const Matrix& GlobalAvgPooling::predict(const Matrix& bottom)
+	{
+		return feedforward(bottom);
+	}
+    const Matrix& GlobalAvgPooling::feedforward(const Matrix& bottom)
+    {
+        return predict(bottom, m_top);
+    }
+    const Matrix& GlobalAvgPooling::predict(const Matrix& bottom, Matrix& top) const
+    {
+        int n_sample = bottom.cols();
+        int hw_in = in_size().size2D();
+        int channels = in_size().channels();
+        //alloc
+        top.resize(channels, n_sample);
+        //the planes of all the batch are the columns of a (hw x channels * samples) matrix
+        Eigen::Map< const Matrix > planes(bottom.data(), hw_in, channels * n_sample);
+        Eigen::Map< RowVector > means(top.data(), channels * n_sample);
+        means.noalias() = planes.colwise().sum() / Scalar(hw_in);
+        return top;
+    }
+    
+    const Matrix& GlobalAvgPooling::backpropagate(const Matrix& bottom, const Matrix& grad) 
+    {
+        CODE_BACKPROPAGATION(
+            int n_sample = bottom.cols();
+            int hw_in = in_size().size2D();
+            int channels = in_size().channels();
+            m_grad_bottom.resize(bottom.rows(), n_sample);
+            //dy/dx = 1/n
+            //dout = 1/n * din, for each pixel of the plane
+            Eigen::Map< Matrix > grad_planes(m_grad_bottom.data(), hw_in, channels * n_sample);
+            Eigen::Map< const RowVector > grad_means(grad.data(), channels * n_sample);
+            grad_planes.rowwise() = grad_means / Scalar(hw_in);
+        )
+        RETURN_BACKPROPAGATION(m_grad_bottom);
+    }
+    
+	void GlobalAvgPooling::update(const Optimizer& optimize)
+	{
+        /* none */
+	}
+    //////////////////////////////////////////////////
+}
@@ -16,7 +16,7 @@ namespace Denn
 			  in_channels))
     , m_dim(in_width, in_height, in_channels, window_width, window_height, in_channels, stride, 0, 0)
     {
-
+        m_table.init(m_dim);
     }
     MaxPooling::MaxPooling 
     (
@@ -47,98 +47,37 @@ namespace Denn
     ////////////////////////////////////////////////// 
 	const Matrix& MaxPooling::predict(const Matrix& bottom)
 	{
+        return predict(bottom, m_top);
+	}
+	const Matrix& MaxPooling::predict(const Matrix& bottom, Matrix& top) const
+	{
         int n_sample = bottom.cols();
-        int hw_in = m_dim.in_image_size();
-        int hw_pool = m_dim.pool_size();
-        int hw_out = m_dim.out_image_size();
-        //alloc and init
-        m_top.resize(int(out_size()), n_sample);
-        m_top.setZero(); 
-        m_top.array() += std::numeric_limits<float>::lowest();
+        //alloc
+        top.resize(int(out_size()), n_sample);
         //max pooling
-        for (int i = 0; i < n_sample; i ++) 
-        {
-            auto image = bottom.col(i);
-            for (int c = 0; c < m_dim.channel_in; c ++) 
-            {
-                for (int i_out = 0; i_out < hw_out; i_out ++) 
-                {
-                    int step_h = i_out / m_dim.width_out;
-                    int step_w = i_out % m_dim.width_out;
-                    // left-top idx of window in raw image
-                    int start_idx = step_h * m_dim.width_in * m_dim.stride + step_w * m_dim.stride;
-                    for (int i_pool = 0; i_pool < hw_pool; i_pool ++) 
-                    {
-                        if (start_idx % m_dim.width_in + i_pool % m_dim.width_kernel >= m_dim.width_in ||
-                            start_idx / m_dim.width_in + i_pool / m_dim.width_kernel >= m_dim.height_in) 
-                        {
-                            continue;  // out of range
-                        }
-                        //index
-                        int pick_idx = start_idx + (i_pool / m_dim.width_kernel) *
-                                       m_dim.width_in + i_pool % m_dim.width_kernel + c * hw_in;
-                        //test
-                        if (image(pick_idx) >= m_top(c * hw_out + i_out, i)) 
-                        {  // max pooling
-                            m_top(c * hw_out + i_out, i) = image(pick_idx);
-                        }
-                    }
-                }
-            }
-        }
-        return m_top;
+        internal::max_pooling<false>(m_dim, m_table, bottom, top, nullptr);
+        return top;
 	}
     const Matrix& MaxPooling::feedforward(const Matrix& bottom)
     {
-        int n_sample = bottom.cols();
-        int hw_in = m_dim.in_image_size();
-        int hw_pool = m_dim.pool_size();
-        int hw_out = m_dim.out_image_size();
-        //alloc and init
-        m_top.resize(int(out_size()), n_sample);
-        m_top.setZero(); 
-        m_top.array() += std::numeric_limits<float>::lowest();
         //backpropagation
         CODE_BACKPROPAGATION(
+            int n_sample = bottom.cols();
+            //alloc
+            m_top.resize(int(out_size()), n_sample);
             m_max_idxs.resize(n_sample, std::vector<int>(int(out_size()), 0));
+            //max pooling + index of max values
+            internal::max_pooling<true>(m_dim, m_table, bottom, m_top, &m_max_idxs);
+            return m_top;
         )
-        //max pooling
-        for (int i = 0; i < n_sample; i ++) 
-        {
-            auto image = bottom.col(i);
-            for (int c = 0; c < m_dim.channel_in; c ++) 
-            {
-                for (int i_out = 0; i_out < hw_out; i_out ++) 
-                {
-                    int step_h = i_out / m_dim.width_out;
-                    int step_w = i_out % m_dim.width_out;
-                    // left-top idx of window in raw image
-                    int start_idx = step_h * m_dim.width_in * m_dim.stride + step_w * m_dim.stride;
-                    for (int i_pool = 0; i_pool < hw_pool; i_pool ++) 
-                    {
-                        if (start_idx % m_dim.width_in + i_pool % m_dim.width_kernel >= m_dim.width_in ||
-                            start_idx / m_dim.width_in + i_pool / m_dim.width_kernel >= m_dim.height_in) 
-                        {
-                            continue;  // out of range
-                        }
-                        //index
-                        int pick_idx = start_idx + (i_pool / m_dim.width_kernel) *
-                                       m_dim.width_in + i_pool % m_dim.width_kernel + c * hw_in;
-                        //test
-                        if (image(pick_idx) >= m_top(c * hw_out + i_out, i)) 
-                        {  // max pooling
-                            m_top(c * hw_out + i_out, i) = image(pick_idx);
-                            CODE_BACKPROPAGATION(
-                                m_max_idxs[i][c * hw_out + i_out] = pick_idx;
-                            )
-                        }
-                    }
-                }
-            }
-        }
-        return m_top;
+        return predict(bottom);
     }
     
+    void MaxPooling::pooling(const Scalar* image, Scalar* top) const
+    {
+        internal::max_pooling_sample<false>(m_dim, m_table, image, top, nullptr);
+    }
+
     const Matrix& MaxPooling::backpropagate(const Matrix& bottom, const Matrix& grad) 
     {
         CODE_BACKPROPAGATION(
@@ -0,0 +1,39 @@
+#include "Denn/Layer/PointwiseConvolutional.h"
+namespace Denn
+{
+	///////////////////////////////////////
+	PointwiseConvolutional::PointwiseConvolutional
+	(
+	  int in_width, int in_height, int in_channels
+	, int out_channels
+	)
+	: Convolutional("pointwise_convolutional", in_width, in_height, in_channels, 1, 1, out_channels, 1, 0, 0)
+	{
+	}
+	PointwiseConvolutional::PointwiseConvolutional
+	(
+		  const Shape& in
+		, const Inputs& metadata
+	)
+	: PointwiseConvolutional
+	(
+	//shapes
+	  in.width(), in.height(), in.channels()
+	//inputs
+	, metadata[0]
+	)
+	{
+	}
+	//////////////////////////////////////////////////
+	const Inputs PointwiseConvolutional::inputs() const
+	{
+		return make_inputs<int>({ m_dim.channel_out });
+	}
+	//////////////////////////////////////////////////
+	Layer::SPtr PointwiseConvolutional::copy() const
+	{
+		auto layer = std::make_shared<PointwiseConvolutional>(*this);
+		return std::static_pointer_cast<Layer>(layer);
+	}
+	//////////////////////////////////////////////////
+}
@@ -5,13 +5,13 @@
 #include <iterator>
 namespace Denn
 {
-	class BestOne : public Mutation
+	class BestOne : public ElementWiseMutation
 	{
 	public:
 
-		BestOne(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		BestOne(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -27,36 +27,40 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
 					//do cross + mutation
 					const Individual& nn_a = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_best)];
-					//
-					auto w_final  = i_final[i_layer][m];
-					auto& x_best = i_best[i_layer][m];
-					auto& x_a    = nn_a[i_layer][m];
-					auto& x_b    = nn_b[i_layer][m];
-					w_final = (x_best + (x_a - x_b) * f).unaryExpr(m_algorithm.clamp_function());
+					//x_best + (x_a - x_b) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_1;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_best, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_a, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_b, i_layer, m);
 				}
 			}
 		}
 	};
 	REGISTERED_MUTATION(BestOne, "best/1")
 
-	class BestTwo : public Mutation
+	class BestTwo : public ElementWiseMutation
 	{
 	public:
 
-		BestTwo(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		BestTwo(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -72,11 +76,14 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -85,27 +92,28 @@ namespace Denn
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_c = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_d = *population[rand_deck.get_random_id(id_best)];
-					//
-					auto w_final = i_final[i_layer][m];
-					auto& w_best = i_best[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
-					auto& x_d = nn_d[i_layer][m];
-					w_final = (w_best + ((x_a - x_b) + (x_c - x_d)) * f).unaryExpr(m_algorithm.clamp_function());
+					//w_best + ((x_a - x_b) + (x_c - x_d)) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_2;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_best, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_a, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_b, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_c, i_layer, m);
+					kernel.m_x[4] = donor(kernel, 4, nn_d, i_layer, m);
 				}
 			}
 		}
 	};
 	REGISTERED_MUTATION(BestTwo, "best/2")
 
-	class GlobalBestOne : public Mutation
+	class GlobalBestOne : public ElementWiseMutation
 	{
 	public:
 
-		GlobalBestOne(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		GlobalBestOne(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -129,36 +137,40 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
 					//do cross + mutation
 					const Individual& nn_a = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_best)];
-					//
-					auto w_final = i_final[i_layer][m];
-					auto& w_best = i_best[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					w_final = (w_best + (x_a - x_b) * f).unaryExpr(m_algorithm.clamp_function());
+					//w_best + (x_a - x_b) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_1;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_best, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_a, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_b, i_layer, m);
 				}
 			}
 		}
 	};
 	REGISTERED_MUTATION(GlobalBestOne, "global_best/1")
 
-	class GlobalBestTwo : public Mutation
+	class GlobalBestTwo : public ElementWiseMutation
 	{
 	public:
 
-		GlobalBestTwo(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		GlobalBestTwo(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -182,11 +194,14 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -195,14 +210,15 @@ namespace Denn
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_c = *population[rand_deck.get_random_id(id_best)];
 					const Individual& nn_d = *population[rand_deck.get_random_id(id_best)];
-					//
-					auto w_final = i_final[i_layer][m];
-					auto& w_best = i_best[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
-					auto& x_d = nn_d[i_layer][m];
-					w_final = (w_best + ((x_a - x_b) + (x_c - x_d)) * f).unaryExpr(m_algorithm.clamp_function());
+					//w_best + ((x_a - x_b) + (x_c - x_d)) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_2;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_best, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_a, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_b, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_c, i_layer, m);
+					kernel.m_x[4] = donor(kernel, 4, nn_d, i_layer, m);
 				}
 			}
 		}
@@ -5,15 +5,15 @@
 #include <iterator>
 namespace Denn
 {
-	class CurrentToBest : public Mutation
+	class CurrentToBest : public ElementWiseMutation
 	{
 	public:
 
-		CurrentToBest(const DennAlgorithm& algorithm):Mutation(algorithm) 
+		CurrentToBest(const DennAlgorithm& algorithm):ElementWiseMutation(algorithm) 
 		{ 
 		}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -26,24 +26,28 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
 					//do cross + mutation
 					const Individual& nn_a = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_target)];
-					//from_archive ? archive[r2] : father(r2);
-					auto  w_final  = i_final[i_layer][m];
-					auto& w_target = i_target[i_layer][m];
-					auto& w_best   = i_best[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					w_final = ( w_target + ((w_best - w_target) + (x_a - x_b)) * f ).unaryExpr(m_algorithm.clamp_function());
+					//w_target + ((w_best - w_target) + (x_a - x_b)) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_CURR_TO;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_target, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, i_best, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_a, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_b, i_layer, m);
 				}
 			}
 		}
@@ -51,14 +55,14 @@ namespace Denn
 	};
 	REGISTERED_MUTATION(CurrentToBest, "curr_best")
 
-	class CurrentToPBest : public Mutation
+	class CurrentToPBest : public ElementWiseMutation
 	{
 	public:
 
 		//required sort
 		virtual bool required_sort() const override { return true; }
 
-		CurrentToPBest(const DennAlgorithm& algorithm):Mutation(algorithm) 
+		CurrentToPBest(const DennAlgorithm& algorithm):ElementWiseMutation(algorithm) 
 		{ 
 			//Get archive
 			if(m_algorithm.evolution_method().get_context_data().get_type() == static_variant_type<Population>())
@@ -69,7 +73,7 @@ namespace Denn
 			m_perc_of_best = m_algorithm.parameters().m_perc_of_best;
 		}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -85,11 +89,14 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(current_np());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -108,13 +115,14 @@ namespace Denn
 					{
 						nn_b =  population[rand_deck.get_random_id(id_target)];
 					}
-					//from_archive ? archive[r2] : father(r2);
-					auto  w_final  = i_final[i_layer][m];
-					auto& w_target = i_target[i_layer][m];
-					auto& w_best   = i_best[i_layer][m];
-					auto& x_a 	   = nn_a[i_layer][m];
-					auto  x_b 	   = (*nn_b)[i_layer][m];
-					w_final = ( w_target + ((w_best - w_target) + (x_a - x_b)) * f ).unaryExpr(m_algorithm.clamp_function());
+					//w_target + ((w_best - w_target) + (x_a - x_b)) * f, x_b from_archive ? archive[r2] : father(r2)
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_CURR_TO;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_target, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, i_best, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_a, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, *nn_b, i_layer, m);
 				}
 			}
 		}
@@ -5,13 +5,13 @@
 #include <iterator>
 namespace Denn
 {
-	class CurrToRandOne : public Mutation
+	class CurrToRandOne : public ElementWiseMutation
 	{
 	public:
 
-		CurrToRandOne(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		CurrToRandOne(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -22,11 +22,14 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -34,13 +37,14 @@ namespace Denn
 					const Individual& nn_a = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_c = *population[rand_deck.get_random_id(id_target)];
-					//
-					auto  w_final = i_final[i_layer][m];
-					auto& w_target = i_target[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
-					w_final = (w_target + ((x_a - w_target) + (x_b - x_c)) * f).unaryExpr(m_algorithm.clamp_function());
+					//w_target + ((x_a - w_target) + (x_b - x_c)) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_CURR_TO;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, i_target, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_a, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_b, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_c, i_layer, m);
 				}
 			}
 		}
@@ -5,13 +5,13 @@
 #include <iterator>
 namespace Denn
 {
-	class DEGL : public Mutation
+	class DEGL : public ElementWiseMutation
 	{
 	public:
 
-		DEGL(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		DEGL(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//... page 6 
 			//https://pdfs.semanticscholar.org/5523/8adbd3d78dc83cf906240727be02f6560470.pdf
@@ -47,11 +47,14 @@ namespace Denn
 			rand_deck_ring_segment.reinit(population.size(), id_target, neighborhood);
 			rand_deck.reset();
 			rand_deck_ring_segment.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -62,48 +65,33 @@ namespace Denn
 
 					const Individual& nn_l_a = *population[rand_deck_ring_segment.get_random_id()];//local a != target
 					const Individual& nn_l_b = *population[rand_deck_ring_segment.get_random_id()];//local b != target
-					//									
-					auto& w_target = i_target[i_layer][m];
-					auto& w_g_best = g_best[i_layer][m];
-					auto& w_l_best = l_best[i_layer][m];
-					auto  w_final   = i_final[i_layer][m];
-
-					auto& x_g_a = nn_g_a[i_layer][m];
-					auto& x_g_b = nn_g_b[i_layer][m];
-					auto& x_l_a = nn_l_a[i_layer][m];
-					auto& x_l_b = nn_l_b[i_layer][m];
-
-					//global
-					Matrix g_m = ( w_target + ((w_g_best - w_target) + (x_g_a - x_g_b)) * f );
-
-					//local
-					Matrix l_m = ( w_target + ((w_l_best - w_target) + (x_l_a - x_l_b)) * f );
-
-					//final (lerp)
-					//from the DEGL's peper
-					//lambda = 1 -> g_m (aka rand-to-best/1)
-					//lambda = 0 -> l_m
-					Scalar* w_final_array = w_final.data();
-					Scalar* w_g_m_array   = g_m.data();
-					Scalar* w_l_m_array   = l_m.data();
-					for(Matrix::Index i=0; i != w_final.size(); ++i)
-						w_final_array[i] = Denn::lerp(w_l_m_array[i], w_g_m_array[i], scalar_weight);
-
-					//clamp
-					w_final = w_final.unaryExpr(m_algorithm.clamp_function());
+					//lerp(l_m, g_m, lambda), from the DEGL's peper
+					//g_m = w_target + ((w_g_best - w_target) + (x_g_a - x_g_b)) * f (global, lambda = 1 -> rand-to-best/1)
+					//l_m = w_target + ((w_l_best - w_target) + (x_l_a - x_l_b)) * f (local, lambda = 0)
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DEGL;
+					kernel.m_f = f;
+					kernel.m_w = scalar_weight;
+					kernel.m_x[0] = donor(kernel, 0, i_target, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, g_best, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_g_a, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_g_b, i_layer, m);
+					kernel.m_x[4] = donor(kernel, 4, l_best, i_layer, m);
+					kernel.m_x[5] = donor(kernel, 5, nn_l_a, i_layer, m);
+					kernel.m_x[6] = donor(kernel, 6, nn_l_b, i_layer, m);
 				}
 			}
 		}
 	};
 	REGISTERED_MUTATION(DEGL, "degl")
 
-	class ProDEGL : public Mutation
+	class ProDEGL : public ElementWiseMutation
 	{
 	public:
 
-		ProDEGL(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		ProDEGL(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//... page 6 
 			//https://pdfs.semanticscholar.org/5523/8adbd3d78dc83cf906240727be02f6560470.pdf
@@ -136,12 +124,18 @@ namespace Denn
 			//set population size in deck
 			rand_deck_ring_segment.reinit(population.size(), id_target, neighborhood);
 			rand_deck_ring_segment.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
+					//the kernel, the target decoded once if packed
+					MutationKernel& kernel = kernels[k];
+					auto w_target = i_target.m_network.genome_matrix(i_layer, m, kernel.m_unpacked[0]);
 					//search near values
 					Scalar v_min[2] { std::numeric_limits<Scalar>::max(),  std::numeric_limits<Scalar>::max() };
 					size_t id_min[2]{ 0, 0 };
@@ -152,7 +146,7 @@ namespace Denn
 						//ref to near
 						const Individual& i_near = *population[n];
 						//search
-						auto dist = distance(i_target[i_layer][m],i_near[i_layer][m]);
+						auto dist = distance(w_target, i_near.m_network.genome_matrix(i_layer, m, kernel.m_unpacked[1]));
 						// dist < min 0
 						if(dist < v_min[0]) 
 						{ 
@@ -178,35 +172,19 @@ namespace Denn
 
 					const Individual& nn_l_a = *population[rand_deck_ring_segment.get_random_id()];//local a != target
 					const Individual& nn_l_b = *population[rand_deck_ring_segment.get_random_id()];//local b != target
-					//									
-					auto& w_target = i_target[i_layer][m];
-					auto& w_g_best = g_best[i_layer][m];
-					auto& w_l_best = l_best[i_layer][m];
-					auto  w_final  = i_final[i_layer][m];
-
-					auto& x_g_a = nn_g_a[i_layer][m];
-					auto& x_g_b = nn_g_b[i_layer][m];					
-					auto& x_l_a = nn_l_a[i_layer][m];
-					auto& x_l_b = nn_l_b[i_layer][m];
-
-					//global
-					Matrix g_m = ( w_target + ((w_g_best - w_target) + (x_g_a - x_g_b)) * f );
-
-					//local
-					Matrix l_m = ( w_target + ((w_l_best - w_target) + (x_l_a - x_l_b)) * f );
-
-					//final (lerp)
-					//from the DEGL's peper
-					//lambda = 1 -> g_m (aka rand-to-best/1)
-					//lambda = 0 -> l_m
-					Scalar* w_final_array = w_final.data();
-					Scalar* w_g_m_array   = g_m.data();
-					Scalar* w_l_m_array   = l_m.data();
-					for(Matrix::Index i=0; i != w_final.size(); ++i)
-						w_final_array[i] = Denn::lerp(w_l_m_array[i], w_g_m_array[i], scalar_weight);
-
-					//clamp
-					w_final = w_final.unaryExpr(m_algorithm.clamp_function());
+					//lerp(l_m, g_m, lambda), from the DEGL's peper
+					//g_m = w_target + ((w_g_best - w_target) + (x_g_a - x_g_b)) * f (global, lambda = 1 -> rand-to-best/1)
+					//l_m = w_target + ((w_l_best - w_target) + (x_l_a - x_l_b)) * f (local, lambda = 0)
+					kernel.m_type = MutationKernel::MK_DEGL;
+					kernel.m_f = f;
+					kernel.m_w = scalar_weight;
+					kernel.m_x[0] = w_target.data();
+					kernel.m_x[1] = donor(kernel, 1, g_best, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_g_a, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_g_b, i_layer, m);
+					kernel.m_x[4] = donor(kernel, 4, l_best, i_layer, m);
+					kernel.m_x[5] = donor(kernel, 5, nn_l_a, i_layer, m);
+					kernel.m_x[6] = donor(kernel, 6, nn_l_b, i_layer, m);
 				}
 			}
 		}
@@ -257,6 +235,8 @@ namespace Denn
 			//local / global network
 			NeuralNetwork nn_l(i_final.m_network);
 			NeuralNetwork nn_g(i_final.m_network);
+			//decoded matrices of packed individuals
+			thread_local Matrix buffers[7];
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
@@ -273,14 +253,14 @@ namespace Denn
 					const Individual& nn_l_a = *population[rand_deck_ring_segment.get_random_id()];//local a != target
 					const Individual& nn_l_b = *population[rand_deck_ring_segment.get_random_id()];//local b != target
 					// target + best								
-					auto& w_target = i_target[i_layer][m];
-					auto& w_g_best = g_best[i_layer][m];
-					auto& w_l_best = l_best[i_layer][m];
+					auto w_target = i_target.m_network.genome_matrix(i_layer, m, buffers[0]);
+					auto w_g_best = g_best.m_network.genome_matrix(i_layer, m, buffers[1]);
+					auto w_l_best = l_best.m_network.genome_matrix(i_layer, m, buffers[2]);
 					// others
-					auto& x_g_a = nn_g_a[i_layer][m];
-					auto& x_g_b = nn_g_b[i_layer][m];					
-					auto& x_l_a = nn_l_a[i_layer][m];
-					auto& x_l_b = nn_l_b[i_layer][m];
+					auto x_g_a = nn_g_a.m_network.genome_matrix(i_layer, m, buffers[3]);
+					auto x_g_b = nn_g_b.m_network.genome_matrix(i_layer, m, buffers[4]);
+					auto x_l_a = nn_l_a.m_network.genome_matrix(i_layer, m, buffers[5]);
+					auto x_l_b = nn_l_b.m_network.genome_matrix(i_layer, m, buffers[6]);
 
 					//global
 					nn_g[i_layer][m] = ( w_target + ((w_g_best - w_target) + (x_g_a - x_g_b)) * f );
@@ -293,8 +273,7 @@ namespace Denn
 			{
 				nn_g.fit
 				(	
-					  m_algorithm.current_batch().features()
-					, m_algorithm.current_batch().labels()
+					  m_algorithm.current_batch()
 					, SGD(*parameters().m_learning_rate
 						 ,*parameters().m_decay
 						 ,*parameters().m_momentum
@@ -302,8 +281,7 @@ namespace Denn
 				);
 				nn_l.fit
 				(	
-					  m_algorithm.current_batch().features()
-					, m_algorithm.current_batch().labels()
+					  m_algorithm.current_batch()
 					, SGD(*parameters().m_learning_rate
 						 ,*parameters().m_decay
 						 ,*parameters().m_momentum
@@ -13,8 +13,8 @@ namespace Denn
 
 		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
 		{
-			//target
-			i_final = *population[id_target];
+			//target (decoded if packed)
+			i_final.unpack_from(*population[id_target]);
 		}
 	};
 	REGISTERED_MUTATION(NoneMutation, "none")
@@ -5,13 +5,13 @@
 #include <iterator>
 namespace Denn
 {
-	class RandOne : public Mutation
+	class RandOne : public ElementWiseMutation
 	{
 	public:
 
-		RandOne(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		RandOne(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -22,11 +22,14 @@ namespace Denn
 			//set population size in deck
 			rand_deck.reinit(population.size());
 			rand_deck.reset();
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -34,25 +37,26 @@ namespace Denn
 					const Individual& nn_a = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_b = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_c = *population[rand_deck.get_random_id(id_target)];
-					//
-					auto  w_final = i_final[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
-					w_final = (x_a + (x_b - x_c) * f).unaryExpr(m_algorithm.clamp_function());
+					//x_a + (x_b - x_c) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_1;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, nn_a, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_b, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_c, i_layer, m);
 				}
 			}
 		}
 	};
 	REGISTERED_MUTATION(RandOne, "rand/1")
 
-	class RandTwo : public Mutation
+	class RandTwo : public ElementWiseMutation
 	{
 	public:
 
-		RandTwo(const DennAlgorithm& algorithm) :Mutation(algorithm) {}
+		RandTwo(const DennAlgorithm& algorithm) :ElementWiseMutation(algorithm) {}
 
-		virtual void operator()(const Population& population, size_t id_target, Individual& i_final) override
+		virtual void kernels(const Population& population, size_t id_target, Individual& i_final, MutationKernels& kernels) override
 		{
 			//alias
 			const auto& f = i_final.m_f;
@@ -62,11 +66,14 @@ namespace Denn
 			auto& rand_deck = random(id_target).deck();
 			//set population size in deck
 			rand_deck.reinit(population.size());
+			//a kernel for each matrix
+			kernels_alloc(i_target, kernels);
+			size_t k = 0;
 			//for each layers
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
 				//weights and baias
-				for (size_t m = 0; m != i_target[i_layer].size(); ++m)
+				for (size_t m = 0; m != i_target[i_layer].size(); ++m, ++k)
 				{
 					//do rand
 					rand_deck.reset();
@@ -76,14 +83,15 @@ namespace Denn
 					const Individual& nn_c = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_d = *population[rand_deck.get_random_id(id_target)];
 					const Individual& nn_e = *population[rand_deck.get_random_id(id_target)];
-					//
-					auto  w_final = i_final[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
-					auto& x_d = nn_d[i_layer][m];
-					auto& x_e = nn_e[i_layer][m];
-					w_final = (x_a + ((x_b - x_c) + (x_d - x_e)) * f).unaryExpr(m_algorithm.clamp_function());
+					//x_a + ((x_b - x_c) + (x_d - x_e)) * f
+					MutationKernel& kernel = kernels[k];
+					kernel.m_type = MutationKernel::MK_DIFF_2;
+					kernel.m_f = f;
+					kernel.m_x[0] = donor(kernel, 0, nn_a, i_layer, m);
+					kernel.m_x[1] = donor(kernel, 1, nn_b, i_layer, m);
+					kernel.m_x[2] = donor(kernel, 2, nn_c, i_layer, m);
+					kernel.m_x[3] = donor(kernel, 3, nn_d, i_layer, m);
+					kernel.m_x[4] = donor(kernel, 4, nn_e, i_layer, m);
 				}
 			}
 		}
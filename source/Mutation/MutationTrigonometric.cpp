@@ -30,6 +30,8 @@ namespace Denn
 			Scalar p_a = nn_a.m_eval / p;
 			Scalar p_b = nn_b.m_eval / p;
 			Scalar p_c = nn_c.m_eval / p;
+			//decoded matrices of packed donors
+			thread_local Matrix buffers[3];
 			//for each layer
 			for (size_t i_layer = 0; i_layer != i_target.size(); ++i_layer)
 			{
@@ -38,9 +40,9 @@ namespace Denn
 				{
 					//mutation
 					auto  w_final = i_final[i_layer][m];
-					auto& x_a = nn_a[i_layer][m];
-					auto& x_b = nn_b[i_layer][m];
-					auto& x_c = nn_c[i_layer][m];
+					auto  x_a = nn_a.m_network.genome_matrix(i_layer, m, buffers[0]);
+					auto  x_b = nn_b.m_network.genome_matrix(i_layer, m, buffers[1]);
+					auto  x_c = nn_c.m_network.genome_matrix(i_layer, m, buffers[2]);
 					w_final = (x_a + x_b + x_c) / Scalar(3) + (p_b -p_a) * (x_a - x_b) + (p_c - p_b) * (x_b - x_c) + (p_a - p_c) * (x_c - x_a);
 					w_final = w_final.unaryExpr(m_algorithm.clamp_function());
 				}
@@ -31,6 +31,52 @@ namespace Denn
 	Random& Mutation::main_random()					  const { return m_algorithm.main_random(); }
 	Random& Mutation::random()					      const { return m_algorithm.random(); }
 	#endif 
+
+	//ElementWiseMutation
+	ElementWiseMutation::ElementWiseMutation(const DennAlgorithm& algorithm)
+	: Mutation(algorithm)
+	{
+	}
+
+	void ElementWiseMutation::operator()(const Population& population, size_t id_target, Individual& output)
+	{
+		thread_local MutationKernels kernels;
+		this->kernels(population, id_target, output, kernels);
+		mutate(kernels, output);
+	}
+
+	void ElementWiseMutation::mutate(const MutationKernels& kernels, Individual& output) const
+	{
+		const auto& clamp = m_algorithm.clamp_function();
+		size_t k = 0;
+		//for each layers
+		for (size_t i_layer = 0; i_layer != output.size(); ++i_layer)
+		{
+			//weights and baias
+			for (size_t m = 0; m != output[i_layer].size(); ++m, ++k)
+			{
+				auto w_final = output[i_layer][m];
+				Scalar* w_final_array = w_final.data();
+				for (Matrix::Index e = 0; e != w_final.size(); ++e)
+					w_final_array[e] = clamp(kernels[k](e));
+			}
+		}
+	}
+
+	void ElementWiseMutation::kernels_alloc(const Individual& target, MutationKernels& kernels)
+	{
+		size_t n_matrices = 0;
+		for (size_t i_layer = 0; i_layer != target.size(); ++i_layer) n_matrices += target[i_layer].size();
+		//no realloc while the kernels are filled (the decoded donors are referenced)
+		kernels.resize(n_matrices);
+	}
+
+	const Scalar* ElementWiseMutation::donor(MutationKernel& kernel, size_t x, const Individual& individual, size_t i_layer, size_t m)
+	{
+		//packed (fp16/bf16 population or archive), decode the matrix
+		return individual.m_network.genome_matrix(i_layer, m, kernel.m_unpacked[x]).data();
+	}
+
 	//map
 	static std::map< std::string, MutationFactory::CreateObject >& m_map()
 	{
@@ -1,6 +1,9 @@
 #include "Denn/NeuralNetwork.h"
+#include "Denn/DataSet.h"
+#include "Denn/StaticNetwork.h"
 #include "Denn/Utilities/Math.h"
 #include "Denn/Utilities/Vector.h"
+#include "Denn/Utilities/SoftmaxCrossEntropy.h"
 namespace Denn
 {	
 	////////////////////////////////////////////////////////////////
@@ -11,46 +14,271 @@ namespace Denn
 	//  default copy constructor  and assignment operator
 	NeuralNetwork::NeuralNetwork(const NeuralNetwork& nn)
 	{
+		//packed, the same packed genome
+		if (nn.genome_packed())
+		{
+			copy_packed_from(nn, nn.m_genome_precision);
+			return;
+		}
 		//alloc
 		m_layers.clear();
 		//copy all layers
 		for (size_t i = 0; i != nn.size(); ++i)
 		{
-			add_layer(nn[i].copy()->get_ptr());
+			m_layers.push_back(nn[i].copy());
+			m_layers.back()->network() = this;
 		}
+		//a single buffer
+		genome_bind();
+		//same fusion
+		if (nn.fused()) fuse();
 	}
 	NeuralNetwork& NeuralNetwork::operator= (const NeuralNetwork & nn)
 	{
+		copy_from(nn);
+		//self return
+		return *this;
+	}	
+	bool NeuralNetwork::same_layout(const NeuralNetwork& nn) const
+	{
+		if (size() != nn.size()) return false;
+		for (size_t i = 0; i != size(); ++i)
+		{
+			if (!m_layers[i]->same_layout(nn[i])) return false;
+		}
+		return true;
+	}
+	void NeuralNetwork::copy_from(const NeuralNetwork & nn)
+	{
+		//self
+		if (this == &nn) return;
+		//packed source, the same packed genome (it has no parameters)
+		if (nn.genome_packed())
+		{
+			copy_packed_from(nn, nn.m_genome_precision);
+			return;
+		}
+		//packed, alloc the parameters
+		if (genome_packed())
+		{
+			m_genome_precision = GenomePrecision::GP_FLOAT;
+			m_genome_packed.clear();
+			m_genome_packed.shrink_to_fit();
+			genome_bind();
+		}
+		//same layout, copy the genome
+		if (same_layout(nn))
+		{
+			genome() = nn.genome();
+			if (nn.fused() && !fused()) fuse();
+			return;
+		}
+		//external buffer (e.g. population arena)
+		Scalar* external = m_genome.size() ? nullptr : m_genome_ptr;
+		size_t  external_size = genome_size();
 		//alloc
 		m_layers.clear();
 		//copy all layers
 		for (size_t i = 0; i != nn.size(); ++i)
 		{
-			add_layer(nn[i].copy()->get_ptr());
+			m_layers.push_back(nn[i].copy());
+			m_layers.back()->network() = this;
+		}
+		//new size
+		size_t new_size = 0;
+		for (auto& layer : m_layers) new_size += layer->parameters_size();
+		//a single buffer, keep the external one if it is possible
+		if (external && external_size == new_size) genome_bind(external);
+		else 									   genome_bind();
+		//same fusion
+		m_fusion = false;
+		m_fused_layers.clear();
+		m_static = nullptr;
+		if (nn.fused()) fuse();
+	}	
+	void NeuralNetwork::copy_packed_from(const NeuralNetwork& nn, GenomePrecision precision)
+	{
+		//nothing to encode
+		if (this == &nn || precision == GenomePrecision::GP_FLOAT)
+		{
+			copy_from(nn);
+			genome_pack(precision);
+			return;
 		}
-		//self return
-		return *this;
+		//free the parameters
+		for (auto& layer : m_layers) layer->parameters_release();
+		ColVector().swap(m_genome);
+		m_genome_ptr = nullptr;
+		//copy all layers (without parameters)
+		if (!same_layout(nn))
+		{
+			m_layers.clear();
+			for (size_t i = 0; i != nn.size(); ++i)
+			{
+				m_layers.push_back(nn[i].copy());
+				m_layers.back()->parameters_release();
+				m_layers.back()->network() = this;
+			}
+			m_genome_size = nn.genome_size();
+			m_fusion = false;
+			m_fused_layers.clear();
+			m_static = nullptr;
+		}
+		//encode (the buffer is reused)
+		m_genome_packed.resize(nn.genome_size());
+		if (!nn.genome_packed())
+		{
+			internal::pack_genome(precision, nn.m_genome_ptr, m_genome_packed.data(), nn.genome_size());
+		}
+		else if (nn.m_genome_precision == precision)
+		{
+			std::copy(nn.m_genome_packed.begin(), nn.m_genome_packed.end(), m_genome_packed.begin());
+		}
+		else
+		{
+			//from a precision to another
+			ColVector genome(nn.genome_size());
+			internal::unpack_genome(nn.m_genome_precision, nn.m_genome_packed.data(), genome.data(), nn.genome_size());
+			internal::pack_genome(precision, genome.data(), m_genome_packed.data(), nn.genome_size());
+		}
+		m_genome_precision = precision;
+		//same fusion
+		if (nn.fused() && !fused()) fuse();
 	}	
+	void NeuralNetwork::unpack_from(const NeuralNetwork& nn)
+	{
+		//float source
+		if (!nn.genome_packed())
+		{
+			copy_from(nn);
+			return;
+		}
+		//another layout, the same packed genome and then decode it
+		if (genome_packed() || !same_layout(nn))
+		{
+			copy_packed_from(nn, nn.m_genome_precision);
+			genome_unpack();
+			return;
+		}
+		//decode in place
+		internal::unpack_genome(nn.m_genome_precision, nn.m_genome_packed.data(), m_genome_ptr, genome_size());
+		if (nn.fused() && !fused()) fuse();
+	}
 	/////////////////////////////////////////////////////////////////////////
 	void NeuralNetwork::add_layer(const Layer::SPtr& layer)
 	{
 		m_layers.push_back(layer->copy());
 		m_layers.back()->network() = this;
+		//a single buffer
+		genome_bind();
+		//update the fusion
+		if (m_fusion) fuse();
+	}
+	void NeuralNetwork::fuse()
+	{
+		m_fusion = true;
+		m_fused_layers.assign(size(), {});
+		for (size_t i = 0; i < size();)
+		{
+			//next layers
+			std::vector<Layer*> next_layers;
+			for (size_t j = i + 1; j < size(); ++j) next_layers.push_back(m_layers[j].get());
+			//fused
+			size_t n_fused = std::min(m_layers[i]->fusion(next_layers), next_layers.size());
+			m_fused_layers[i].assign(next_layers.begin(), next_layers.begin() + n_fused);
+			i += 1 + n_fused;
+		}
+		//static shapes
+		m_static = StaticNetworkFactory::get(*this);
+	}
+	/////////////////////////////////////////////////////////////////////////
+	size_t NeuralNetwork::genome_size() const
+	{
+		return m_genome_size;
+	}
+	void NeuralNetwork::genome_bind(Scalar* buffer)
+	{
+		//size
+		m_genome_size = 0;
+		for (auto& layer : m_layers) m_genome_size += layer->parameters_size();
+		//self storage
+		ColVector storage;
+		if (!buffer)
+		{
+			storage.resize(m_genome_size);
+			storage.setZero();
+			buffer = storage.data();
+		}
+		//layer by layer
+		Scalar* ptr = buffer;
+		for (auto& layer : m_layers)
+		{
+			layer->parameters_bind(ptr);
+			ptr += layer->parameters_size();
+		}
+		//free the old storage
+		m_genome.swap(storage);
+		m_genome_ptr = buffer;
+	}
+	AlignedMapColVector NeuralNetwork::genome()
+	{
+		return AlignedMapColVector(m_genome_ptr, genome_size());
+	}
+	ConstAlignedMapColVector NeuralNetwork::genome() const
+	{
+		return ConstAlignedMapColVector(m_genome_ptr, genome_size());
+	}
+	void NeuralNetwork::genome_pack(GenomePrecision precision)
+	{
+		//nothing to do
+		if (genome_packed() || precision == GenomePrecision::GP_FLOAT) return;
+		//encode
+		m_genome_packed.resize(genome_size());
+		internal::pack_genome(precision, m_genome_ptr, m_genome_packed.data(), genome_size());
+		m_genome_precision = precision;
+		//free the parameters
+		for (auto& layer : m_layers) layer->parameters_release();
+		ColVector().swap(m_genome);
+		m_genome_ptr = nullptr;
+	}
+	void NeuralNetwork::genome_unpack()
+	{
+		//nothing to do
+		if (!genome_packed()) return;
+		//alloc
+		genome_bind();
+		//decode
+		internal::unpack_genome(m_genome_precision, m_genome_packed.data(), m_genome_ptr, genome_size());
+		m_genome_precision = GenomePrecision::GP_FLOAT;
+		std::vector<uint16_t>().swap(m_genome_packed);
+	}
+	void NeuralNetwork::genome_unpack(Scalar* out) const
+	{
+		if (genome_packed()) internal::unpack_genome(m_genome_precision, m_genome_packed.data(), out, genome_size());
+		else                 std::copy(m_genome_ptr, m_genome_ptr + genome_size(), out);
+	}
+	ConstAlignedMapMatrix NeuralNetwork::genome_matrix(size_t layer, size_t matrix, Matrix& buffer) const
+	{
+		//float, the parameters of the layer
+		const Layer& i_layer = *m_layers[layer];
+		auto shape = i_layer[matrix];
+		if (!genome_packed()) return shape;
+		//offset of the matrix
+		size_t offset = 0;
+		for (size_t i = 0; i != layer; ++i) offset += m_layers[i]->parameters_size();
+		for (size_t i = 0; i != matrix; ++i) offset += Layer::parameters_align(i_layer[i].size());
+		//decode
+		buffer.resize(shape.rows(), shape.cols());
+		internal::unpack_genome(m_genome_precision, m_genome_packed.data() + offset, buffer.data(), size_t(buffer.size()));
+		return ConstAlignedMapMatrix(buffer.data(), shape.rows(), shape.cols());
 	}
 	/////////////////////////////////////////////////////////////////////////
 	const Matrix& NeuralNetwork::predict(const Matrix& input) const
 	{
 		//no layer?
 		denn_assert(m_layers.size());
-		//input layer
-		m_layers[0]->predict(input);
-		//hidden layers
-		for (size_t i = 1; i < size(); ++i)
-		{
-			m_layers[i]->predict(m_layers[i-1]->ff_output());
-		}
-		//return
-		return m_layers[size()-1]->ff_output();
+		//all layers
+		return layers_pass(input, 0, size(), false, m_fusion);
 	}	
 	const Matrix& NeuralNetwork::feedforward(const Matrix& input, Random* random) const
 	{
@@ -58,25 +286,258 @@ namespace Denn
 		denn_assert(m_layers.size());
 		//set random engine (dropout)
 		m_random = random;
-		//input layer
-		m_layers[0]->feedforward(input);
-		//hidden layers
-		for (size_t i = 1; i < size(); ++i)
+		//all layers
+		return layers_pass(input, 0, size(), true, m_fusion);
+	}	
+	const Matrix& NeuralNetwork::predict(const Matrix& input, Workspace& workspace, bool logits) const
+	{
+		//no layer?
+		denn_assert(m_layers.size());
+		//all layers
+		return workspace_pass(input, workspace, false, false, logits);
+	}
+	const Matrix& NeuralNetwork::feedforward(const Matrix& input, Workspace& workspace, Random* random, bool logits) const
+	{
+		//no layer?
+		denn_assert(m_layers.size());
+		//set random engine (dropout)
+		m_random = random;
+		//all layers
+		return workspace_pass(input, workspace, true, false, logits);
+	}
+	const Matrix& NeuralNetwork::quantized_predict(const Matrix& input, Workspace& workspace, bool logits) const
+	{
+		//no layer?
+		denn_assert(m_layers.size());
+		//all layers
+		return workspace_pass(input, workspace, false, true, logits);
+	}
+	const Matrix& NeuralNetwork::predict(const DataSet& input, Workspace& workspace, bool logits) const
+	{
+		if (auto sparse = input.sparse_input())
+		{
+			denn_assert(m_layers.size());
+			return workspace_pass(*sparse, workspace, false, false, logits);
+		}
+		denn_assert(m_layers.size());
+		return workspace_pass(input.features(), workspace, false, false, logits, 0, input.im2col_cache());
+	}
+	const Matrix& NeuralNetwork::feedforward(const DataSet& input, Workspace& workspace, Random* random, bool logits) const
+	{
+		if (auto sparse = input.sparse_input())
+		{
+			denn_assert(m_layers.size());
+			m_random = random;
+			return workspace_pass(*sparse, workspace, true, false, logits);
+		}
+		denn_assert(m_layers.size());
+		m_random = random;
+		return workspace_pass(input.features(), workspace, true, false, logits, 0, input.im2col_cache());
+	}
+	const Matrix& NeuralNetwork::quantized_predict(const DataSet& input, Workspace& workspace, bool logits) const
+	{
+		if (auto sparse = input.sparse_input())
 		{
-			m_layers[i]->feedforward(m_layers[i-1]->ff_output());
+			denn_assert(m_layers.size());
+			return workspace_pass(*sparse, workspace, false, true, logits);
+		}
+		denn_assert(m_layers.size());
+		return workspace_pass(input.features(), workspace, false, true, logits, 0, input.im2col_cache());
+	}
+	const Matrix& NeuralNetwork::workspace_pass(const Matrix& input, Workspace& workspace, bool train, bool quantized, bool logits, size_t from, internal::Im2ColCache* cache) const
+	{
+		//without the softmax
+		denn_assert(!logits || softmax_output());
+		size_t end = logits ? size() - 1 : size();
+		//static kernel
+		if (!from && !quantized && m_fusion && m_static && !genome_packed())
+		{
+			Matrix& top = workspace.output_for(input);
+			m_static(*this, input, top, logits);
+			return top;
+		}
+		const Matrix* bottom = &input;
+		for (size_t i = from; i < end;)
+		{
+			//the output is never the input
+			Matrix& top = workspace.output_for(*bottom);
+			//input layer on the shared input (with its fused group)
+			if (i == 0 && cache && m_layers[0]->cached_input())
+			{
+				static const std::vector<Layer*> no_fused_layers;
+				bool fused = !quantized && m_fusion && m_fused_layers[0].size() && m_fused_layers[0].size() < end;
+				bottom = &m_layers[0]->cached_predict(*bottom, *cache, fused ? m_fused_layers[0] : no_fused_layers, quantized, top);
+				i += fused ? 1 + m_fused_layers[0].size() : 1;
+				continue;
+			}
+			//int8 kernels
+			if (quantized)
+			{
+				bottom = &m_layers[i]->quantized_predict(*bottom, top);
+				++i;
+				continue;
+			}
+			//fused kernel (all the group before the end)
+			if (m_fusion && m_fused_layers[i].size() && i + m_fused_layers[i].size() < end)
+			{
+				bottom = &m_layers[i]->fused_predict(*bottom, m_fused_layers[i], top);
+				i += 1 + m_fused_layers[i].size();
+				continue;
+			}
+			//a layer
+			if (train) bottom = &m_layers[i]->feedforward(*bottom, top);
+			else       bottom = &m_layers[i]->predict(*bottom, top);
+			++i;
 		}
 		//return
-		return m_layers[size()-1]->ff_output();
-	}	
+		return *bottom;
+	}
+	const Matrix& NeuralNetwork::layers_pass(const Matrix& input, size_t from, size_t to, bool train, bool fusion) const
+	{
+		//static kernel (to = size() - 1, without the last softmax)
+		bool logits = to + 1 == size() && softmax_output();
+		if (fusion && m_static && from == 0 && (to == size() || logits) && !genome_packed())
+		{
+			Matrix& top = m_layers[to - 1]->ff_output_buffer();
+			m_static(*this, input, top, logits);
+			return top;
+		}
+		const Matrix* bottom = &input;
+		for (size_t i = from; i < to;)
+		{
+			//fused kernel (all the group before the end)
+			if (fusion && m_fused_layers[i].size() && i + m_fused_layers[i].size() < to)
+			{
+				bottom = &m_layers[i]->fused_predict(*bottom, m_fused_layers[i], m_fused_layers[i].back()->ff_output_buffer());
+				i += 1 + m_fused_layers[i].size();
+				continue;
+			}
+			//a layer
+			if (train) bottom = &m_layers[i]->feedforward(*bottom);
+			else       bottom = &m_layers[i]->predict(*bottom);
+			++i;
+		}
+		//return
+		return *bottom;
+	}
+	const Matrix& NeuralNetwork::layers_pass(const SparseMatrix& input, size_t to, bool train, bool fusion) const
+	{
+		denn_assert(m_layers[0]->sparse_input());
+		//input layer (the layers fused with it are evaluated one by one)
+		const Matrix& top = m_layers[0]->sparse_predict(input, m_layers[0]->ff_output_buffer());
+		size_t next = std::min(fusion ? 1 + m_fused_layers[0].size() : 1, to);
+		const Matrix& output = layers_pass(top, 1, next, train, false);
+		return layers_pass(output, next, to, train, fusion);
+	}
+	const Matrix& NeuralNetwork::workspace_pass(const SparseMatrix& input, Workspace& workspace, bool train, bool quantized, bool logits) const
+	{
+		denn_assert(m_layers[0]->sparse_input());
+		//input layer, exact also if quantized
+		const Matrix& top = m_layers[0]->sparse_predict(input, workspace.output_for(input));
+		return workspace_pass(top, workspace, train, quantized, logits, 1);
+	}
+	const Matrix& NeuralNetwork::output(bool logits) const
+	{
+		//no layer?
+		denn_assert(m_layers.size());
+		denn_assert(!logits || softmax_output());
+		//return
+		return m_layers[logits ? size()-2 : size()-1]->ff_output();
+	}
+	bool NeuralNetwork::softmax_output() const
+	{
+		return size() > 1 && m_layers.back()->name() == "softmax";
+	}
+	bool NeuralNetwork::quantizable() const
+	{
+		for (auto& layer : m_layers)
+		{
+			if (layer->size() && !layer->quantizable()) return false;
+		}
+		return true;
+	}
+	void NeuralNetwork::predict(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, bool logits)
+	{
+		population_pass(networks, input, nullptr, nullptr, logits);
+	}
+	void NeuralNetwork::feedforward(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, const std::vector<Random*>& randoms, bool logits)
+	{
+		denn_assert(networks.size() == randoms.size());
+		population_pass(networks, input, nullptr, &randoms, logits);
+	}
+	void NeuralNetwork::predict(const std::vector<const NeuralNetwork*>& networks, const DataSet& input, bool logits)
+	{
+		if (auto sparse = input.sparse_input())
+			for (const NeuralNetwork* network : networks)
+				network->layers_pass(*sparse, logits ? network->size() - 1 : network->size(), false, network->m_fusion);
+		else
+			population_pass(networks, input.features(), input.im2col_cache(), nullptr, logits);
+	}
+	void NeuralNetwork::feedforward(const std::vector<const NeuralNetwork*>& networks, const DataSet& input, const std::vector<Random*>& randoms, bool logits)
+	{
+		denn_assert(networks.size() == randoms.size());
+		if (auto sparse = input.sparse_input())
+			for (size_t n = 0; n != networks.size(); ++n)
+			{
+				//set random engine (dropout)
+				networks[n]->m_random = randoms[n];
+				networks[n]->layers_pass(*sparse, logits ? networks[n]->size() - 1 : networks[n]->size(), true, networks[n]->m_fusion);
+			}
+		else
+			population_pass(networks, input.features(), input.im2col_cache(), &randoms, logits);
+	}
+	void NeuralNetwork::population_pass(const std::vector<const NeuralNetwork*>& networks, const Matrix& input, internal::Im2ColCache* cache, const std::vector<Random*>* randoms, bool logits)
+	{
+		//no networks?
+		if (!networks.size()) return;
+		//no layer?
+		denn_assert(networks[0]->size());
+		//input layers
+		thread_local std::vector<Layer*> layers;
+		layers.resize(networks.size());
+		for (size_t n = 0; n != networks.size(); ++n)
+		{
+			denn_assert(networks[n]->size() == networks[0]->size());
+			//set random engine (dropout)
+			if (randoms) networks[n]->m_random = (*randoms)[n];
+			//first layer
+			layers[n] = networks[n]->m_layers[0].get();
+		}
+		//input layer, all the networks in a single pass if it's supported
+		if (layers[0]->population_feedforward(layers, input, cache))
+		{
+			//hidden layers (the layers fused with the input layer are evaluated one by one)
+			for (const NeuralNetwork* network : networks)
+			{
+				size_t end = logits ? network->size() - 1 : network->size();
+				size_t next = std::min(network->m_fusion ? 1 + network->m_fused_layers[0].size() : 1, end);
+				const Matrix& output = network->layers_pass(network->m_layers[0]->ff_output(), 1, next, bool(randoms), false);
+				network->layers_pass(output, next, end, bool(randoms), network->m_fusion);
+			}
+		}
+		else
+		{
+			for (const NeuralNetwork* network : networks)
+			{
+				size_t end = logits ? network->size() - 1 : network->size();
+				network->layers_pass(input, 0, end, bool(randoms), network->m_fusion);
+			}
+		}
+	}
 	void NeuralNetwork::backpropagate(const Matrix& input, const Matrix& target, OutputLoss oltype)
+	{
+		backpropagate(input, nullptr, target, oltype);
+	}
+	void NeuralNetwork::backpropagate(const Matrix& input, const SparseMatrix* sparse, const Matrix& target, OutputLoss oltype)
 	{
 		//ptrs
-		Layer::SPtr first_layer = m_layers[0];
 		Layer::SPtr last_layer = m_layers[size() - 1];
 
 		// Let output layer compute back-propagation data
 		// MSE
 		Matrix eval;
+		// Layer that receives eval
+		int last = int(size()) - 1;
 		switch (oltype)
 		{
 		default:
@@ -89,6 +550,15 @@ namespace Denn
 			eval = ((pred.array() - target.array()) * Scalar(2)) / Scalar(nobs);
 		}
 		break;
+		case Denn::NeuralNetwork::SOFTMAX_CROSS_ENTROPY:
+		if (softmax_output())
+		{
+			// d(L)/d(z) = (softmax(z) - y)/n, the softmax layer is skipped
+			internal::softmax_cross_entropy_gradient(last_layer->ff_output(), target, eval);
+			last = int(size()) - 2;
+			break;
+		}
+		//falls through (as multiclass)
 		case Denn::NeuralNetwork::MULTICLASS_CROSS_ENTROPY:
 		{
 			// Compute the derivative of the input of this layer
@@ -116,36 +586,40 @@ namespace Denn
 		break;
 		}
 
-		// If there is only one hidden layer, "prev_layer_data" will be the input data
-		if (size() == 1)
+		// Compute gradients from the last layer to the first one ("prev_layer_data" of the first layer is the input data)
+		const Matrix* grad = &eval;
+		for (int i = last; i >= 0; i--)
 		{
-			first_layer->backpropagate(input, eval);
-			return;
+			if (!i && sparse) m_layers[i]->sparse_backpropagate(*sparse, *grad);
+			else              m_layers[i]->backpropagate(i ? m_layers[i - 1]->ff_output() : input, *grad);
+			grad = &m_layers[i]->bp_output();
 		}
-
-		// Compute gradients for the last hidden layer
-		last_layer->backpropagate(m_layers[size() - 2]->ff_output(), eval);
-
-		// Compute gradients for all the hidden layers except for the first one and the last one
-		for (int i = size() - 2; i > 0; i--)
-		{
-			m_layers[i]->backpropagate(m_layers[i - 1]->ff_output(), m_layers[i + 1]->bp_output());
-		}
-
-		// Compute gradients for the first layer
-		first_layer->backpropagate(input, m_layers[1]->bp_output());
 	}
 	void NeuralNetwork::fit(const Matrix& input, const Matrix& output, 
 							const Optimizer& opt, OutputLoss type)
 	{
-		//->
-		feedforward(input, opt.random());
+		//-> (without fusion, backpropagation needs the output of each layer)
+		m_random = opt.random();
+		layers_pass(input, 0, size(), true, false);
 		//<-
 		backpropagate(input, output, type);
 		//update
 		for (size_t i = 0; i < size(); ++i)
 			m_layers[i]->update(opt);
 	}
+	void NeuralNetwork::fit(const DataSet& dataset, const Optimizer& opt, OutputLoss type)
+	{
+		auto sparse = dataset.sparse_input();
+		if (!sparse) return fit(dataset.features(), dataset.labels(), opt, type);
+		//->
+		m_random = opt.random();
+		layers_pass(*sparse, size(), true, false);
+		//<-
+		backpropagate(dataset.features(), sparse, dataset.labels(), type);
+		//update
+		for (size_t i = 0; i < size(); ++i)
+			m_layers[i]->update(opt);
+	}
 	/////////////////////////////////////////////////////////////////////////
 	//no 0 
 	void NeuralNetwork::no_0_weights()
@@ -179,12 +653,14 @@ namespace Denn
 	}
 	void NeuralNetwork::apply_mask(NeuralNetwork& mask, NeuralNetwork& parent)
 	{
+		//a packed parent is decoded matrix by matrix
+		thread_local Matrix p_buffer;
 		for(size_t l=0;l < size(); ++l)
 		for(size_t m=0;m < (*this)[l].size(); ++m)
 		{
 			auto t_array = (*this)[l][m].array();
 			auto m_array = mask[l][m].array();
-			auto p_array = parent[l][m].array();
+			auto p_array = parent.genome_matrix(l, m, p_buffer).array();
 			for(size_t a=0; a < t_array.size(); ++a)
 				t_array(a) = lerp<Scalar>(p_array(a), t_array(a), m_array(a));
 		}
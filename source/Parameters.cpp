@@ -7,6 +7,7 @@
 #include "Denn/Instance.h"
 #include "Denn/Version.h"
 #include "Denn/Utilities/Networks.h"
+#include "Denn/Utilities/Transcendental.h"
 #include <sstream>
 #include <iostream>
 
@@ -41,6 +42,16 @@ namespace Denn
         ParameterInfo {
             m_seed, "Random generator seed", { "-sd"  }
         },
+        ParameterInfo {
+            m_random_generator, "Random number generator (mt19937 or philox, counter-based)", { "-rgen"  },
+            [this](Arguments& args) -> bool 
+            {
+				m_random_generator = args.get_string();
+				Random::Generator generator;
+				return Random::generator_by_name(*m_random_generator, generator);
+            }
+            , { "string", { "mt19937", "philox" } }
+        },
         ParameterInfo {
             m_batch_size, "Batch size", { "-b" },
             [this](Arguments& args) -> bool  
@@ -56,6 +67,9 @@ namespace Denn
         ParameterInfo {
             m_batch_offset, "Batch offset, how many records will be replaced in the next batch [<= batch size]", { "-bo" }
         },
+        ParameterInfo {
+            m_batch_prefetch, "Prepare the next batch on a background thread", { "-bp" }
+        },
         ParameterInfo {
             m_features, "Set the number of Features given in input when you want to test a neural network", { "-nf" }
         },
@@ -236,6 +250,20 @@ namespace Denn
 			, { m_evolution_type,{ Variant("JADE"), Variant("SHADE"), Variant("L-SHADE"), Variant("MAB-SHADE"), Variant("UCB1SHADE") } }
 			, "Archive size (JADE/SHADE/L-SHADE/MAB-SHADE/UCB1SHADE)",{ "-as" }
 		},				
+		ParameterInfo{
+			  m_archive_precision
+			, { m_evolution_type,{ Variant("JADE"), Variant("SHADE"), Variant("L-SHADE"), Variant("MAB-SHADE"), Variant("UCB1SHADE") } }
+			, "Storage of the genomes of the archive (float, fp16, bf16)",{ "-ap" }
+			, [this](Arguments& args) -> bool
+			{
+				//get precision
+				m_archive_precision = args.get_string();
+				//test
+				GenomePrecision precision;
+				return genome_precision_from_string(*m_archive_precision, precision);
+			}
+			, { "string", { "float", "fp16", "bf16" } }
+		},
 		ParameterInfo{
 			  m_f_cr_adapt
 			, { m_evolution_type,{ Variant("JADE") } }
@@ -417,6 +445,51 @@ namespace Denn
         ParameterInfo{ 
             m_threads_pop, "Number of threads using for  generate a new population", { "-tp"  }
         },
+        ParameterInfo{ 
+              m_activation_precision, "Accuracy of exp/log/tanh of the activations and of the losses (exact, fast, approx)", { "-acp"  }
+            , [this](Arguments& args) -> bool
+            {
+                //get precision
+                m_activation_precision = args.get_string();
+                //test
+                TranscendentalPrecision precision;
+                return transcendental_precision_from_string(*m_activation_precision, precision);
+            }
+            , { "string", { "exact", "fast", "approx" } }
+        },
+        ParameterInfo{ 
+            m_population_batch, "Number of individuals evaluated together on the same batch (0 = disabled)", { "-pb"  }
+        },
+        ParameterInfo{ 
+            m_population_arena, "Store the genomes of all the individuals in a single buffer", { "-pa"  }
+        },
+        ParameterInfo{ 
+              m_genome_precision, "Storage of the genomes of parents and sons (float, fp16, bf16), a 16 bits genome is decoded to be mutated and evaluated (no population arena and population batch)", { "-gp"  }
+            , [this](Arguments& args) -> bool
+            {
+                //get precision
+                m_genome_precision = args.get_string();
+                //test
+                GenomePrecision precision;
+                return genome_precision_from_string(*m_genome_precision, precision);
+            }
+            , { "string", { "float", "fp16", "bf16" } }
+        },
+        ParameterInfo{ 
+            m_im2col_cache_size, "Max number of values of the shared im2col of an input (validation/test set, batch), the samples over it are lowered at each evaluation", { "-im2c"  }
+        },
+        ParameterInfo{ 
+            m_prescreening, "Evaluate the sons with int8 products first, the exact evaluation only if they are close to or better than the parent (only networks of fully connected layers, the convolutional ones are always evaluated exactly)", { "-ps"  }
+        },
+        ParameterInfo{ 
+            m_prescreening_margin, "Relative margin on the eval of the parent, a son worse than it by more than the margin is discarded without the exact evaluation", { "-psm"  }
+        },
+        ParameterInfo{ 
+            m_prescreening_output, "Path of the output of the csv, which will contain the rate of the sons discarded by the pre-screening for each generation", { "-pso"  }
+        },
+        ParameterInfo{ 
+            m_fused_loss, "Compute the cross entropy from the input of the last softmax (log-sum-exp), without the probabilities", { "-fl"  }
+        },
         ParameterInfo{
             "Print list of instances", { "--instances-list", "-ilist"  }, 
             [this](Arguments& args) -> bool { std::cout << InstanceFactory::names_of_instances() << std::endl; return true; } 
@@ -81,6 +81,18 @@ namespace Denn
 		return new_pop;
 	}
 
+	void Population::copy_from(const Population& population)
+	{
+		//same size
+		m_individuals.resize(population.size());
+		//copy
+		for(size_t i = 0;i != size(); ++i)
+		{
+			if(m_individuals[i]) m_individuals[i]->copy_from(*population[i]);
+			else                 m_individuals[i] = population[i]->copy();
+		}
+	}
+
 	std::vector < Individual::SPtr >& Population::as_vector()
 	{
 		return m_individuals;
@@ -91,6 +103,53 @@ namespace Denn
 		return m_individuals;
 	}
 	////////////////////////////////////////////////////////////////////////
+	//IndividualPool
+	Individual::SPtr IndividualPool::copy(const Individual& individual)
+	{
+		while(m_individuals.size())
+		{
+			//get last
+			Individual::SPtr free_individual = m_individuals.back();
+			m_individuals.pop_back();
+			//reuse it only if no one else has it
+			if(free_individual.use_count() == 1)
+			{
+				free_individual->copy_from(individual);
+				return free_individual;
+			}
+		}
+		//alloc
+		return individual.copy();
+	}
+	Individual::SPtr IndividualPool::copy(const Individual& individual, GenomePrecision precision)
+	{
+		Individual::SPtr packed_individual;
+		while(m_individuals.size() && !packed_individual)
+		{
+			//get last
+			Individual::SPtr free_individual = m_individuals.back();
+			m_individuals.pop_back();
+			//reuse it only if no one else has it
+			if(free_individual.use_count() == 1) packed_individual = free_individual;
+		}
+		//alloc
+		if(!packed_individual) packed_individual = std::make_shared<Individual>();
+		packed_individual->copy_packed_from(individual, precision);
+		return packed_individual;
+	}
+	void IndividualPool::release(const Individual::SPtr& individual)
+	{
+		if(individual) m_individuals.push_back(individual);
+	}
+	void IndividualPool::release(const Population& population)
+	{
+		for(const Individual::SPtr& individual : population) release(individual);
+	}
+	void IndividualPool::clear()
+	{
+		m_individuals.clear();
+	}
+	////////////////////////////////////////////////////////////////////////
 	//init population
 	void DoubleBufferPopulation::init(
 		  size_t np
@@ -100,17 +159,46 @@ namespace Denn
 		, Evaluation& loss_function
 		, ThreadPool* thread_pool
 		, RandomFunctionThread thread_random
+		, bool use_arena
+		, GenomePrecision precision
 	)
 	{
 		//minimize?
 		m_minimize_loss_function = loss_function.minimize();
 		parents().m_minimize_loss_function = m_minimize_loss_function;
 		sons().m_minimize_loss_function = m_minimize_loss_function;
+		//pool
+		m_thread_pool = thread_pool;
+		//storage, the arena is a float buffer
+		m_genome_precision = precision;
+		use_arena = use_arena && precision == GenomePrecision::GP_FLOAT;
+		//alloc arena, parents in [0, np), sons in [np, 2np)
+		if(use_arena)
+		{
+			m_arena.resize(i_default->m_network.genome_size(), 2 * np);
+			m_arena.setZero();
+		}
+		else 
+		{
+			m_arena.resize(0, 0);
+		}
+		//copy layout
+		auto copy_layout = [&](size_t i)
+		{
+			parents()[i] = i_default->copy();
+			sons()[i] = i_default->copy();
+			//into the arena
+			if(use_arena)
+			{
+				parents()[i]->m_network.genome_bind(m_arena.col(i).data());
+				sons()[i]->m_network.genome_bind(m_arena.col(np + i).data());
+			}
+			//packed
+			sons()[i]->m_network.genome_pack(m_genome_precision);
+		};
 		//init
 		if(thread_pool && thread_random)
 		{
-			//alloc promises
-			PromiseList promises;
 			//eval
 			Population& p_ref = parents();
 			Population& s_ref = sons();
@@ -118,13 +206,12 @@ namespace Denn
 			p_ref.resize(np);
 			s_ref.resize(np);
 			//parallel
-			for (size_t i = 0; i != np; ++i)
+			thread_pool->parallel_for(0, np, 0, [&](size_t start, size_t end)
 			{
-				promises.push_back(thread_pool->push_task([&,i]()
+				for (size_t i = start; i != end; ++i)
 				{
 					//copy layout
-					p_ref[i] = i_default->copy();
-					s_ref[i] = i_default->copy();
+					copy_layout(i);
 					//build fun
 					auto rand_weight = [=](Scalar weight) -> Scalar
 					{ 
@@ -140,10 +227,10 @@ namespace Denn
 					}
 					//eval
 					p_ref[i]->m_eval = loss_function((NeuralNetwork&)*p_ref[i], dataset);
-				}));
-			}
-			//wait
-			for (auto& p : promises) p.wait();
+					//packed
+					p_ref[i]->m_network.genome_pack(m_genome_precision);
+				}
+			})->wait();
 		}
 		else 
 		{
@@ -157,8 +244,7 @@ namespace Denn
 			for (size_t i = 0; i != np; ++i)
 			{
 				//copy layout
-				p_ref[i] = i_default->copy();
-				s_ref[i] = i_default->copy();
+				copy_layout(i);
 				//build
 				auto rand_weight = [=](Scalar weight) -> Scalar
 				{ 
@@ -174,6 +260,8 @@ namespace Denn
 				}
 				//eval
 				p_ref[i]->m_eval = loss_function((NeuralNetwork&)*p_ref[i], dataset);
+				//packed
+				p_ref[i]->m_network.genome_pack(m_genome_precision);
 			}
 		}
 	}
@@ -311,21 +399,14 @@ namespace Denn
 		//init all -1
 		swap_list.resize(size());
 		std::fill(swap_list.begin(), swap_list.end(), -1);
+		//closest parents
+		thread_local std::vector<size_t> closest;
+		crowding_closest_parents(closest);
 		//swap
 		for (size_t i = 1; i < size(); ++i)
 		{
 			//search target
-			int target_i = 0;
-			Scalar terget_dist = distance<const NeuralNetwork, const NeuralNetwork>(sons()[i]->m_network, parents()[0]->m_network);
-			for (size_t j = 1; j < size(); ++j)
-			{
-				Scalar j_dist = distance<const NeuralNetwork, const NeuralNetwork>(sons()[i]->m_network, parents()[j]->m_network);
-				if (j_dist < terget_dist)
-				{
-					target_i = j;
-					terget_dist = j_dist;
-				}
-			}
+			int target_i = int(closest[i]);
 			//target eval default = the closest
 			Scalar parent_eval = parents()[target_i]->m_eval;
 			//else the last swapped
@@ -340,6 +421,99 @@ namespace Denn
 		}
 	}
 
+	void DoubleBufferPopulation::crowding_closest_parents(std::vector<size_t> &closest) const
+	{
+		//refs
+		const Population& p_ref = parents();
+		const Population& s_ref = sons();
+		const size_t np = size();
+		//alloc
+		closest.resize(np);
+		if (!np) return;
+		//exact search (first of the closests), only on the candidates
+		auto exact_closest = [&](size_t i, const std::function<bool(size_t)>& candidate) -> size_t
+		{
+			size_t target_i = np;
+			Scalar target_dist = 0;
+			for (size_t j = 0; j < np; ++j)
+			{
+				if (!candidate(j)) continue;
+				Scalar j_dist = distance<const NeuralNetwork, const NeuralNetwork>(s_ref[i]->m_network, p_ref[j]->m_network);
+				if (target_i == np || j_dist < target_dist)
+				{
+					target_i = j;
+					target_dist = j_dist;
+				}
+			}
+			return target_i;
+		};
+		//genome size
+		const size_t genome_size = p_ref[0]->m_network.genome_size();
+		const Scalar eps = std::numeric_limits<Scalar>::epsilon();
+		bool same_genome_size = Scalar(genome_size) * eps < Scalar(0.5);
+		for (size_t i = 0; i != np && same_genome_size; ++i)
+		{
+			same_genome_size = p_ref[i]->m_network.genome_size() == genome_size
+							&& s_ref[i]->m_network.genome_size() == genome_size;
+		}
+		//can't use a single matrix
+		if (!same_genome_size)
+		{
+			for (size_t i = 0; i != np; ++i)
+				closest[i] = exact_closest(i, [](size_t) { return true; });
+			return;
+		}
+		//genomes as columns, centered on the parents mean (distances don't change, the norms get smaller)
+		thread_local Matrix tl_parents_genomes;
+		thread_local Matrix tl_sons_genomes;
+		Matrix& parents_genomes = tl_parents_genomes;
+		Matrix& sons_genomes = tl_sons_genomes;
+		parents_genomes.resize(genome_size, np);
+		sons_genomes.resize(genome_size, np);
+		for (size_t i = 0; i != np; ++i)
+		{
+			p_ref[i]->m_network.genome_unpack(parents_genomes.col(i).data());
+			s_ref[i]->m_network.genome_unpack(sons_genomes.col(i).data());
+		}
+		ColVector mean = parents_genomes.rowwise().mean();
+		parents_genomes.colwise() -= mean;
+		sons_genomes.colwise() -= mean;
+		//squared norms
+		RowVector parents_norms = parents_genomes.colwise().squaredNorm();
+		RowVector sons_norms = sons_genomes.colwise().squaredNorm();
+		const Scalar parents_norm_max = parents_norms.maxCoeff();
+		//bound of the error of |s|^2 + |p|^2 - 2 s.p (dot products + centering)
+		const Scalar gamma = (Scalar(genome_size) * eps) / (Scalar(1) - Scalar(genome_size) * eps);
+		const Scalar error_factor = Scalar(2) * gamma + Scalar(8) * eps;
+		//a block of sons
+		auto closest_of_block = [&](size_t start, size_t end)
+		{
+			//sons x parents dot products
+			thread_local Matrix dots;
+			dots.noalias() = sons_genomes.middleCols(start, end - start).transpose() * parents_genomes;
+			//for each son
+			for (size_t i = start; i != end; ++i)
+			{
+				auto dist_pow2 = (sons_norms(i) + parents_norms.array() - Scalar(2) * dots.row(i - start).array()).eval();
+				//all the parents which can be the closest
+				const Scalar error = error_factor * (sons_norms(i) + parents_norm_max);
+				const Scalar limit = dist_pow2.minCoeff() + Scalar(2) * error;
+				closest[i] = exact_closest(i, [&](size_t j) { return dist_pow2(j) <= limit; });
+			}
+		};
+		//blocks of sons
+		const size_t block_size = 32;
+		if (m_thread_pool)
+		{
+			m_thread_pool->parallel_for(0, np, block_size, closest_of_block)->wait();
+		}
+		else 
+		{
+			for (size_t start = 0; start < np; start += block_size)
+				closest_of_block(start, std::min(start + block_size, np));
+		}
+	}
+
 	std::vector<int> DoubleBufferPopulation::parent_swap_list() const
 	{
 		std::vector<int> swap_list;
@@ -375,19 +549,19 @@ namespace Denn
 		//init
 		if(thread_pool && thread_random)
 		{	
-			//alloc promises
-			PromiseList promises;
 			//eval
 			Population& p_ref = parents();
 			Population& s_ref = sons();
 			//parallel
-			for (size_t i = 0; i != p_ref.size(); ++i)
+			thread_pool->parallel_for(0, p_ref.size(), 0, [&](size_t start, size_t end)
 			{
-				promises.push_back(thread_pool->push_task([&,i]()
+				for (size_t i = start; i != end; ++i)
 				{
 					//Copy default params
 					p_ref[i]->copy_attributes(*i_default);
 					s_ref[i]->copy_attributes(*i_default);
+					//new weights in float
+					p_ref[i]->m_network.genome_unpack();
 					//build fun
 					auto rand_weight = [=](Scalar weight) -> Scalar
 					{ 
@@ -403,10 +577,10 @@ namespace Denn
 					}
 					//eval
 					p_ref[i]->m_eval = loss_function((NeuralNetwork&)*p_ref[i], dataset);
-				}));
-			}
-			//wait
-			for (auto& p : promises) p.wait();	
+					//packed
+					p_ref[i]->m_network.genome_pack(m_genome_precision);
+				}
+			})->wait();	
 		}
 		else 
 		{			
@@ -419,6 +593,8 @@ namespace Denn
 				//Copy default params
 				p_ref[i]->copy_attributes(*i_default);
 				s_ref[i]->copy_attributes(*i_default);
+				//new weights in float
+				p_ref[i]->m_network.genome_unpack();
 				//build
 				auto rand_weight = [=](Scalar weight) -> Scalar
 				{ 
@@ -434,10 +610,13 @@ namespace Denn
 				}
 				//eval
 				p_ref[i]->m_eval = loss_function((NeuralNetwork&)*p_ref[i], dataset);
+				//packed
+				p_ref[i]->m_network.genome_pack(m_genome_precision);
 			}
 		}
 		//must copy, The Best Individual can't to be changed during the DE process
-		parents()[where_put_best] = best->copy();
+		parents()[where_put_best]->copy_from(*best);
 		parents()[where_put_best]->m_eval = loss_function((NeuralNetwork&)*parents()[where_put_best], dataset);
+		parents()[where_put_best]->m_network.genome_pack(m_genome_precision);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "Denn/StaticNetwork.h"
+#include <sstream>
+
+namespace Denn
+{
+	//map
+	static std::map< std::string, NeuralNetwork::StaticPredict >& sn_map()
+	{
+		static std::map< std::string, NeuralNetwork::StaticPredict > sn_map;
+		return sn_map;
+	}
+	//public
+	NeuralNetwork::StaticPredict StaticNetworkFactory::get(const NeuralNetwork& network)
+	{
+		return get(topology(network));
+	}
+	NeuralNetwork::StaticPredict StaticNetworkFactory::get(const std::string& topology)
+	{
+		//find
+		auto it = sn_map().find(topology);
+		//return
+		return it == sn_map().end() ? nullptr : it->second;
+	}
+	void StaticNetworkFactory::append(const std::string& topology, NeuralNetwork::StaticPredict predict)
+	{
+		//add
+		sn_map()[topology] = predict;
+	}
+	std::string StaticNetworkFactory::topology(const NeuralNetwork& network)
+	{
+		std::stringstream sout;
+		for (size_t i = 0; i != network.size(); ++i)
+		{
+			if (i) sout << " ";
+			sout << network[i].name() << "(" << network[i].in_size().size3D() << "," << network[i].out_size().size3D() << ")";
+		}
+		return sout.str();
+	}
+	//list of topologies
+	std::vector< std::string > StaticNetworkFactory::list_of_topologies()
+	{
+		std::vector< std::string > list;
+		for (const auto & pair : sn_map()) list.push_back(pair.first);
+		return list;
+	}
+	////////////////////////////////////////////////////////////////////////
+	//topologies of the templates (wdbc, har, esr, mnist)
+	using WDBCNetwork = StaticNetwork< 30,  StaticFullyConnected<50>, StaticSigmoid, StaticFullyConnected<2>, StaticSoftmax >;
+	using HARNetwork  = StaticNetwork< 561, StaticFullyConnected<50>, StaticSigmoid, StaticFullyConnected<6>, StaticSigmoid, StaticSoftmax >;
+	using ESRNetwork  = StaticNetwork< 178, StaticFullyConnected<50>, StaticSigmoid, StaticFullyConnected<2>, StaticSigmoid, StaticSoftmax >;
+	using MNISTNetwork = StaticNetwork< 784, StaticFullyConnected<10>, StaticSigmoid, StaticSoftmax >;
+	REGISTERED_STATIC_NETWORK(WDBCNetwork, WDBCNetwork)
+	REGISTERED_STATIC_NETWORK(HARNetwork,  HARNetwork)
+	REGISTERED_STATIC_NETWORK(ESRNetwork,  ESRNetwork)
+	REGISTERED_STATIC_NETWORK(MNISTNetwork, MNISTNetwork)
+}
@@ -2,37 +2,65 @@
 
 namespace Denn
 {
+	//wait the prefetch (an error of the last prefetch is dropped)
+	TestSetStream::~TestSetStream()
+	{
+		if (m_next_ready.valid()) m_next_ready.wait();
+	}
+
 	//start
-	void TestSetStream::start_read_batch(size_t batch_size, size_t rows_offset)
+	void TestSetStream::start_read_batch(size_t batch_size, size_t rows_offset, bool prefetch)
 	{
+		//stop last prefetch
+		wait_next_batch();
 		//start
 		m_cache_cols_read = 0;
 		m_batch_size = batch_size;
 		m_batch_offset = rows_offset;
+		m_batch_start = 0;
+		m_prefetch = prefetch;
 		m_dataset->start_read_batch();
 		//init batch
 		m_batch.m_features_shape = Shape(m_dataset->get_main_header_info().m_n_features);
 		m_batch.m_labels_shape = Shape(m_dataset->get_main_header_info().m_n_classes); 
-		//int features
+		m_next_batch.m_features_shape = m_batch.m_features_shape;
+		m_next_batch.m_labels_shape = m_batch.m_labels_shape;
+		//int features (sparse features: an empty placeholder)
+		const bool sparse = m_dataset->get_main_header_info().sparse();
 		m_batch.features().conservativeResize
 		(
-			  m_dataset->get_main_header_info().m_n_features
+			  sparse ? 0 : m_dataset->get_main_header_info().m_n_features
 			, m_batch_size
 		);
+		m_batch.sparse_features().resize(sparse ? m_dataset->get_main_header_info().m_n_features : 0, sparse ? m_batch_size : 0);
 		//init labels
 		m_batch.labels().conservativeResize
 		(
 			  m_dataset->get_main_header_info().m_n_classes
 			, m_batch_size
 		);
+		m_batch.classes().conservativeResize(m_batch_size);
 		//read
-		read_batch(m_batch_size);
+		compute_next_batch(m_batch_size);
+		push_next_batch();
+		//prefetch
+		if (m_prefetch)
+			m_next_ready = std::async(std::launch::async, [this]() { compute_next_batch(m_batch_offset); });
 	}
 
 	//read
 	DataSetScalar& TestSetStream::read_batch()
 	{
-		return read_batch(m_batch_offset);
+		//next samples
+		if (m_prefetch) wait_next_batch();
+		else            compute_next_batch(m_batch_offset);
+		//put into the ring
+		push_next_batch();
+		//prefetch the next
+		if (m_prefetch)
+			m_next_ready = std::async(std::launch::async, [this]() { compute_next_batch(m_batch_offset); });
+		//get
+		return m_batch;
 	}
 
 	//get last
@@ -40,8 +68,82 @@ namespace Denn
 	{
 		return m_batch;
 	}
+
+	//wait
+	void TestSetStream::wait_next_batch()
+	{
+		if (m_next_ready.valid()) m_next_ready.get();
+	}
+
+	//overwrite the columns [start, start + count) of out with the columns [from, from + count) of in,
+	//out is kept uncompressed, so only the storage of the overwritten columns is written
+	static void sparse_overwrite_cols(const SparseMatrix& in, int from, int count, SparseMatrix& out, int start)
+	{
+		//uncompressed (once), the overwritten columns are emptied
+		if (out.isCompressed()) out.reserve(Eigen::VectorXi::Zero(out.cols()));
+		for (int j = start; j < start + count; ++j) out.innerNonZeroPtr()[j] = 0;
+		//grow only the columns without room (with slack for the next samples)
+		const int* in_outer = in.outerIndexPtr();
+		Eigen::VectorXi room = Eigen::VectorXi::Zero(out.cols());
+		bool grow = false;
+		for (int j = 0; j < count; ++j)
+		{
+			const int need = internal::sparse_col_end(in, from + j) - in_outer[from + j];
+			if (out.outerIndexPtr()[start + j] + need > out.outerIndexPtr()[start + j + 1])
+			{
+				room(start + j) = 2 * need;
+				grow = true;
+			}
+		}
+		if (grow) out.reserve(room);
+		//write
+		int* outer = out.outerIndexPtr();
+		int* nnz = out.innerNonZeroPtr();
+		int* inner = out.innerIndexPtr();
+		Scalar* values = out.valuePtr();
+		for (int j = 0; j < count; ++j)
+		{
+			const int k = in_outer[from + j];
+			const int n = internal::sparse_col_end(in, from + j) - k;
+			std::copy(in.innerIndexPtr() + k, in.innerIndexPtr() + k + n, inner + outer[start + j]);
+			std::copy(in.valuePtr() + k, in.valuePtr() + k + n, values + outer[start + j]);
+			nnz[start + j] = n;
+		}
+	}
+
+	//replace the oldest samples, the batch is a ring: the columns are a rotation of the logical batch
+	//(no sample is moved, the per-sample results are the same, only the order of the sums over the batch changes)
+	void TestSetStream::push_next_batch()
+	{
+		//n new samples
+		const size_t n_cols_update = m_next_batch.features().cols();
+		//from the oldest, up to the end of the ring
+		const size_t first = std::min(n_cols_update, m_batch_size - m_batch_start);
+		const size_t second = n_cols_update - first;
+		m_batch.features().middleCols(m_batch_start, first) = m_next_batch.features().leftCols(first);
+		m_batch.labels().middleCols(m_batch_start, first) = m_next_batch.labels().leftCols(first);
+		m_batch.classes().segment(m_batch_start, first) = m_next_batch.classes().head(first);
+		//from the begin
+		if (second)
+		{
+			m_batch.features().leftCols(second) = m_next_batch.features().rightCols(second);
+			m_batch.labels().leftCols(second) = m_next_batch.labels().rightCols(second);
+			m_batch.classes().head(second) = m_next_batch.classes().tail(second);
+		}
+		//sparse features, only the outgoing columns
+		if (m_next_batch.sparse())
+		{
+			sparse_overwrite_cols(m_next_batch.sparse_features(), 0, int(first), m_batch.sparse_features(), int(m_batch_start));
+			if (second) sparse_overwrite_cols(m_next_batch.sparse_features(), int(first), int(second), m_batch.sparse_features(), 0);
+		}
+		//the next oldest
+		m_batch_start = m_batch_size ? (m_batch_start + n_cols_update) % m_batch_size : 0;
+		//invalidate the lowered batch
+		if (auto cache = m_batch.im2col_cache()) cache->update();
+	}
+
 	//read
-	DataSetScalar& TestSetStream::read_batch(size_t n_cols_update)
+	void TestSetStream::compute_next_batch(size_t n_cols_update)
 	{
 		//test
 		denn_assert(n_cols_update <= m_batch_size);
@@ -50,40 +152,53 @@ namespace Denn
 		const size_t c_labels = m_dataset->get_main_header_info().m_n_classes;
 		size_t offset = 0;
 		size_t n_read = 0;
-		//shift (not equal)
-		if (n_cols_update && n_cols_update < m_batch_size)
-		{
-			//put the last N values on the top (for all features)
-			m_batch.features() = Denn::shift_left(m_batch.features(), n_cols_update);
-			//put the last N values on the top
-			m_batch.labels() = Denn::shift_left(m_batch.labels(), n_cols_update);
-			//start to n_rows
-			offset = m_batch.features().cols() - n_cols_update;
-		}
+		const bool sparse = m_dataset->get_main_header_info().sparse();
+		int sparse_col = 0;
+		//alloc
+		m_next_batch.features().resize(sparse ? 0 : c_features, n_cols_update);
+		m_next_batch.labels().resize(c_labels, n_cols_update);
+		m_next_batch.sparse_features().resize(sparse ? c_features : 0, sparse ? n_cols_update : 0);
 		//copy next
 		while (n_read < n_cols_update)
 		{
 			//get remaning
 			size_t read_remaning = n_cols_update - n_read;
 			//restart
-			if (m_cache_cols_read >= m_cache_batch.features().cols())
+			if (m_cache_cols_read >= size_t(m_cache_view.features().cols()))
 				m_cache_cols_read = 0;
 			//init case
 			if(!m_cache_cols_read)
-				m_dataset->read_batch(m_cache_batch);
+				read_cache();
 			//compute n rows to read
-			size_t n_samples = m_cache_batch.features().cols() - m_cache_cols_read;
+			size_t n_samples = m_cache_view.features().cols() - m_cache_cols_read;
 			size_t to_read = std::min<size_t>(n_samples, read_remaning);
 			//copy all features
-			m_batch.features().block(0, offset, c_features, to_read).noalias() = m_cache_batch.features().block(0, m_cache_cols_read, c_features, to_read);
+			if (sparse)
+				internal::sparse_append_cols(m_cache_batch.sparse_features(), int(m_cache_cols_read), int(to_read), m_next_batch.sparse_features(), sparse_col);
+			else
+				m_next_batch.features().block(0, offset, c_features, to_read).noalias() = m_cache_view.features().block(0, m_cache_cols_read, c_features, to_read);
 			//copy all labels
-			m_batch.labels().block(0, offset, c_labels, to_read).noalias() = m_cache_batch.labels().block(0, m_cache_cols_read, c_labels, to_read);
+			m_next_batch.labels().block(0, offset, c_labels, to_read).noalias() = m_cache_view.labels().block(0, m_cache_cols_read, c_labels, to_read);
 			//move
 			n_read += to_read;
 			offset += to_read;
 			m_cache_cols_read += to_read;
 		}
-		//get
-		return m_batch;
+		if (sparse) m_next_batch.sparse_features().finalize();
+		//classes of the new samples
+		m_next_batch.update_classes();
+	}
+
+	//read next batch
+	void TestSetStream::read_cache()
+	{
+		//a view of the batch, if the loader can (aligned data of a mapped file), else a copy
+		if (m_dataset->read_batch_view(m_cache_view)) return;
+		//read
+		if (!m_dataset->read_batch(m_cache_batch))
+		{
+			throw std::runtime_error("a batch of the input file is corrupt");
+		}
+		m_cache_view.map(m_cache_batch);
 	}
-}
\ No newline at end of file
+}
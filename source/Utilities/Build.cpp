@@ -2,6 +2,8 @@
 #include "Denn/Parameters.h"
 #include "Denn/SerializeOutput.h"
 #include "Denn/Utilities/Build.h"
+#include "Denn/Utilities/Transcendental.h"
+#include "Denn/Utilities/Convolution.h"
 
 namespace Denn
 {
@@ -78,6 +80,10 @@ namespace Denn
 		Eigen::initParallel();
 		}
 		#endif
+		//exp/log/tanh kernels (global, as the threads of Eigen)
+		transcendental_precision_from_string(*parameters.m_activation_precision, transcendental_precision());
+		//size of the shared im2col of the inputs (global as well)
+		internal::Im2ColCache::max_size(*parameters.m_im2col_cache_size);
 		//parallel (Thread Pool)
 		//ptr
 		std::unique_ptr<ThreadPool> uptr_thpool;
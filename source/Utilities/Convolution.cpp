@@ -0,0 +1,84 @@
+#include "Denn/Config.h"
+#include "Denn/Utilities/Convolution.h"
+
+namespace Denn
+{
+namespace internal
+{
+	//revisions are unique among all the caches
+	static size_t next_revision()
+	{
+		static std::atomic<size_t> revision{ 0 };
+		return ++revision;
+	}
+
+	static std::atomic<size_t>& cache_max_size()
+	{
+		static std::atomic<size_t> size{ size_t(1) << 25 };
+		return size;
+	}
+
+	Im2ColCache::Im2ColCache() 
+	: m_revision(next_revision())
+	{
+	}
+
+	Im2ColCache::Im2ColCache(const Im2ColCache&)
+	: Im2ColCache()
+	{
+	}
+
+	Im2ColCache& Im2ColCache::operator = (const Im2ColCache&)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_lowered.clear();
+		m_revision = next_revision();
+		return *this;
+	}
+
+	size_t Im2ColCache::max_size()
+	{
+		return cache_max_size();
+	}
+
+	void Im2ColCache::max_size(size_t size)
+	{
+		cache_max_size() = size;
+	}
+
+	void Im2ColCache::update()
+	{
+		m_revision = next_revision();
+	}
+
+	std::shared_ptr<const Matrix> Im2ColCache::get(const ConvDims& dim, const Matrix& input)
+	{
+		//samples that fit the cache
+		size_t sample_size = std::max<size_t>(1, size_t(dim.out_image_size()) * size_t(dim.kernel_size()));
+		int samples = int(std::min<size_t>(size_t(input.cols()), max_size() / sample_size));
+		if (!samples) return nullptr;
+		//the first thread computes, the others wait
+		std::unique_lock<std::mutex> lock(m_mutex);
+		const size_t revision = m_revision;
+		Lowered* lowered = nullptr;
+		for (Lowered& cached : m_lowered)
+		{
+			if (cached.m_dim == dim) { lowered = &cached; break; }
+		}
+		if (!lowered)
+		{
+			m_lowered.emplace_back();
+			lowered = &m_lowered.back();
+			lowered->m_dim = dim;
+		}
+		if (lowered->m_revision != revision || lowered->m_data->rows() != samples * dim.out_image_size())
+		{
+			//reuse the buffer if nobody is reading it
+			if (!lowered->m_data || lowered->m_data.use_count() > 1) lowered->m_data = std::make_shared<Matrix>();
+			img_to_col(dim, input, 0, samples, *lowered->m_data);
+			lowered->m_revision = revision;
+		}
+		return lowered->m_data;
+	}
+}
+}
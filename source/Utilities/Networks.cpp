@@ -239,7 +239,8 @@ namespace Denn
 				state = S_READ_TYPE;
 			}
 		}
-		//ok
+		//fused kernels
+		nn.fuse();
 		return std::make_tuple(nn, err, true);
 	}
 
@@ -36,7 +36,16 @@ int main(int argc,const char** argv)
     ////////////////////////////////////////////////////////////////////////////////////////////////
     //execute test
     if (!instance)            return 128;
-    if (!instance->execute()) return 255;
+    try
+    {
+        if (!instance->execute()) return 255;
+    }
+    //e.g. a corrupt input file
+    catch (const std::runtime_error& error)
+    {
+        std::cerr << error.what() << std::endl;
+        return 255;
+    }
     ////////////////////////////////////////////////////////////////////////////////////////////////
 return 0;
 }
@@ -0,0 +1,72 @@
+import os
+import sys
+import json
+import shutil
+import argparse
+import subprocess
+#consts
+ROOT = "tests"
+PATH_DENN = "Release/DENN-float"
+PATH_TMPDIR = os.path.join(ROOT, "_tmp_sparse_")
+PATH_DATASETS = "datasets"
+XOR_SIZE = 6
+BATCH = 5
+
+def build_datasets(tmpdir):
+    #the same samples, stored dense (v1) and sparse (v4)
+    sys.path.append(PATH_DATASETS)
+    from DennDBLib.creator import nbit_parity
+    generator = nbit_parity("xor{}.db".format(XOR_SIZE), nbit=XOR_SIZE, dest_folder=tmpdir, batch_size=10, binary=True)
+    generator.version = 4
+    generator.save("xor{}_sparse.db".format(XOR_SIZE), tmpdir)
+    return [os.path.join(tmpdir, "xor{}.db.gz".format(XOR_SIZE)),
+            os.path.join(tmpdir, "xor{}_sparse.db.gz".format(XOR_SIZE))]
+
+def execute_denn(denn, tmpdir, args):
+    with open(os.path.join(tmpdir, "res.stdout"), "a+") as ofile:
+        return subprocess.call([denn, *args], stdout=ofile, stderr=subprocess.STDOUT)
+
+def read_json(output):
+    with open(output) as fjson:
+        jtext = fjson.read()
+        jtext = jtext.replace("-nan", "-0")
+        jtext = jtext.replace("nan", "0")
+        return json.loads(jtext)
+
+def main(denn, tmpdir):
+    os.makedirs(tmpdir, exist_ok=True)
+    dense, sparse = build_datasets(tmpdir)
+    errors = []
+    results = {}
+    for name, dataset in [("dense", dense), ("sparse", sparse)]:
+        #stream the batches
+        if execute_denn(denn, tmpdir, ["-tt", "dbtest", "-i", dataset, "-b", str(BATCH), "-bo", str(BATCH)]):
+            errors.append("dbtest on the {} dataset".format(name))
+        #evolution
+        output = os.path.join(tmpdir, "de_{}.json".format(name))
+        if execute_denn(denn, tmpdir, ["template/JADE_NN_XOR.config", "input=" + dataset, "seed=1", "gens=50", "full_output=" + output]):
+            errors.append("JADE on the {} dataset".format(name))
+        #backpropagation, the same result on both the datasets
+        output = os.path.join(tmpdir, "bp_{}.json".format(name))
+        if execute_denn(denn, tmpdir, ["template/BP_NN_XOR.config", "input=" + dataset, "seed=1", "full_output=" + output]):
+            errors.append("backpropagation on the {} dataset".format(name))
+        else:
+            results[name] = read_json(output)
+    if len(results) == 2:
+        for key in ["accuracy", "network"]:
+            if results["dense"][key] != results["sparse"][key]:
+                errors.append("backpropagation, {} of the sparse dataset differs from the dense one".format(key))
+    #print
+    for error in errors:
+        print("FAIL:", error)
+    if not errors:
+        print("OK")
+        shutil.rmtree(tmpdir)
+    return len(errors) == 0
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(description="Stream a sparse (v4) dataset with dbtest, JADE and backpropagation")
+    parser.add_argument('--denn', type=str, default=PATH_DENN, help="path of DENN executable")
+    parser.add_argument('--tmpdir', type=str, default=PATH_TMPDIR, help="path of the temporary directory")
+    args = parser.parse_args()
+    sys.exit(0 if main(args.denn, args.tmpdir) else 1)